@@ -0,0 +1,876 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_ARENA_TREE_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_ARENA_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_btree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+/*
+red-black tree whose nodes live in one growable arena and link to each
+other by 32-bit indices: a node is three indices and the value, the top
+bit of the parent index being the colour; slot 0 is the black nil
+erased slots go to a free list and are reused before the arena grows;
+links are position independent, so the arena is relocated as a whole on
+growth and a tree of trivially copyable values is copied with one memcpy
+
+iterators are (tree, index) pairs and survive growth, but references to
+values do not: like in s21::Vector, an insertion may move every value
+an iterator stays bound to the tree object it came from, not to the
+arena: after a swap or a move it indexes whatever that object holds
+then, so unlike std::map both invalidate the iterators of both trees
+at most kMaxNodes values, the arena comes from Allocator rebound to the
+node type
+*/
+template <class Key, class Value, class KeyOfValue, class Compare,
+          class Allocator = std::allocator<Value>>
+class ArenaTree {
+ public:
+  class ArenaTreeIterator;
+  class ArenaTreeConstIterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = ArenaTreeIterator;
+  using const_iterator = ArenaTreeConstIterator;
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+  using allocator_type = Allocator;
+  using tree_type = ArenaTree<Key, Value, KeyOfValue, Compare, Allocator>;
+
+  static constexpr index_type kNil = 0;
+  // the nil takes one slot and the all-ones index marks free slots
+  static constexpr size_type kMaxNodes = (size_type{1} << 31) - 2;
+
+ private:
+  static constexpr index_type kRedBit = index_type{1} << 31;
+  static constexpr index_type kFreeSlot = ~index_type{0};
+  static constexpr size_type kMinCapacity = 16;
+
+  struct Node {
+    index_type parent_;
+    index_type left_;
+    index_type right_;
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+  };
+
+  using alloc_traits = std::allocator_traits<allocator_type>;
+  using node_allocator_type =
+      typename alloc_traits::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
+
+  // copies of such values are their bytes
+  static constexpr bool kBitwiseCopy =
+      std::is_trivially_copy_constructible_v<value_type> &&
+      std::is_trivially_destructible_v<value_type>;
+
+ public:
+  using node_type = Node;
+
+  ArenaTree() : ArenaTree(Compare(), allocator_type()) {}
+
+  explicit ArenaTree(const allocator_type& alloc)
+      : ArenaTree(Compare(), alloc) {}
+
+  explicit ArenaTree(const Compare& comp,
+                     const allocator_type& alloc = allocator_type())
+      : nodes_(nullptr),
+        capacity_(size_type{}),
+        used_(1),
+        free_(kNil),
+        root_(kNil),
+        size_(size_type{}),
+        is_less_(comp),
+        allocator_(alloc) {}
+
+  ArenaTree(const tree_type& other)
+      : ArenaTree(alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())) {
+    CopyTree(other);
+  }
+
+  ArenaTree(tree_type&& other) noexcept : ArenaTree(other.get_allocator()) {
+    swap(other);
+  }
+
+  tree_type& operator=(const tree_type& other) {
+    if (this != &other) {
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (allocator_ != other.allocator_) {
+          clear();
+          ReleaseArena();
+          allocator_ = other.allocator_;
+        }
+      }
+      CopyTree(other);
+    }
+    return *this;
+  }
+
+  // values are moved one by one only if the arena of other cannot be stolen
+  tree_type& operator=(tree_type&& other) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::
+                      value &&
+                  !alloc_traits::is_always_equal::value) {
+      if (allocator_ != other.allocator_) {
+        is_less_ = other.is_less_;
+        key_of_ = other.key_of_;
+        reserve(other.size_);
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+          EmplaceUnique(key_of_(*it), std::move(*it));
+        }
+        other.clear();
+        return *this;
+      }
+    }
+    swap(other);
+    return *this;
+  }
+
+  ~ArenaTree() {
+    clear();
+    ReleaseArena();
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
+  }
+
+  // the arena is kept for the next insertions, like a cleared Vector
+  void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (index_type index = 1; index < used_; ++index) {
+        if (nodes_[index].parent_ != kFreeSlot) ValueAt(index).~value_type();
+      }
+    }
+    used_ = 1;
+    free_ = kNil;
+    root_ = kNil;
+    size_ = 0;
+  }
+
+  // after reserve(n) the tree can grow up to n values without relocating
+  void reserve(size_type n) {
+    if (n > kMaxNodes) throw std::length_error("value exceeds maximum size");
+    if (n + 1 > capacity_) {
+      Node* arena = node_traits::allocate(allocator_, n + 1);
+      try {
+        Relocate(arena);
+      } catch (...) {
+        node_traits::deallocate(allocator_, arena, n + 1);
+        throw;
+      }
+      ReleaseArena();
+      nodes_ = arena;
+      capacity_ = n + 1;
+    }
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::min(kMaxNodes,
+                    std::numeric_limits<size_type>::max() / sizeof(Node));
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return EmplaceUnique(key_of_(value), value);
+  }
+
+  // the key is only known once the value is built
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return EmplaceUnique(key_of_(value), std::move(value));
+  }
+
+  /*
+  one descent: returns the value equal to key or builds one from args in
+  a new node hung where the search ended; key may live in the arena, the
+  new value is built before the arena is relocated
+  */
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceUnique(const K& key, Args&&... args) {
+    index_type parent = kNil;
+    bool left = false;
+    for (index_type node = root_; node != kNil;) {
+      int order = ThreeWayCompare(is_less_, key, KeyAt(node));
+      if (order == 0) return {iterator(this, node), false};
+      parent = node;
+      left = order < 0;
+      node = left ? nodes_[node].left_ : nodes_[node].right_;
+    }
+    index_type node = NewNode(std::forward<Args>(args)...);
+    LinkNode(node, parent, left);
+    return {iterator(this, node), true};
+  }
+
+  // EmplaceUnique that first tries the leaf slot right before hint
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceHint(iterator hint, const K& key,
+                                        Args&&... args) {
+    index_type next = hint.index_;
+    index_type prev = PrevNode(next);
+    if (root_ == kNil || (next != kNil && !is_less_(key, KeyAt(next))) ||
+        (prev != kNil && !is_less_(KeyAt(prev), key))) {
+      return EmplaceUnique(key, std::forward<Args>(args)...);
+    }
+    // the predecessor has no right child or next has no left one
+    bool left = next != kNil && nodes_[next].left_ == kNil;
+    index_type node = NewNode(std::forward<Args>(args)...);
+    LinkNode(node, left ? next : prev, left);
+    return {iterator(this, node), true};
+  }
+
+  iterator begin() noexcept {
+    return iterator(this, root_ == kNil ? kNil : MostLeft(root_));
+  }
+
+  iterator end() noexcept { return iterator(this, kNil); }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(const_cast<tree_type*>(this)->begin());
+  }
+
+  const_iterator end() const noexcept {
+    return const_iterator(const_cast<tree_type*>(this)->end());
+  }
+
+  /*
+  return iterator on end if not found
+  else returns iterator on the value with the given key;
+  key may be of any type Compare can order against key_type
+  */
+  template <class K>
+  iterator find(const K& key) const noexcept {
+    index_type node = root_;
+    while (node != kNil) {
+      int order = ThreeWayCompare(is_less_, key, KeyAt(node));
+      if (order == 0) break;
+      node = order < 0 ? nodes_[node].left_ : nodes_[node].right_;
+    }
+    return iterator(const_cast<tree_type*>(this), node);
+  }
+
+  template <class K>
+  bool contains(const K& key) const noexcept {
+    return find(key).index_ != kNil;
+  }
+
+  // first value not less than key, end() if there is none
+  template <class K>
+  iterator lower_bound(const K& key) const noexcept {
+    index_type bound = kNil;
+    for (index_type node = root_; node != kNil;) {
+      if (is_less_(KeyAt(node), key)) {
+        node = nodes_[node].right_;
+      } else {
+        bound = node;
+        node = nodes_[node].left_;
+      }
+    }
+    return iterator(const_cast<tree_type*>(this), bound);
+  }
+
+  // first value greater than key, end() if there is none
+  template <class K>
+  iterator upper_bound(const K& key) const noexcept {
+    index_type bound = kNil;
+    for (index_type node = root_; node != kNil;) {
+      if (is_less_(key, KeyAt(node))) {
+        bound = node;
+        node = nodes_[node].left_;
+      } else {
+        node = nodes_[node].right_;
+      }
+    }
+    return iterator(const_cast<tree_type*>(this), bound);
+  }
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    iterator first = lower_bound(key);
+    iterator last = first;
+    if (first.index_ != kNil && !is_less_(key, KeyAt(first.index_))) ++last;
+    return {first, last};
+  }
+
+  void swap(tree_type& other) noexcept {
+    std::swap(nodes_, other.nodes_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(used_, other.used_);
+    std::swap(free_, other.free_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(is_less_, other.is_less_);
+    std::swap(key_of_, other.key_of_);
+    // the move assignment steals the arena through swap too
+    if constexpr (alloc_traits::propagate_on_container_swap::value ||
+                  alloc_traits::propagate_on_container_move_assignment::
+                      value) {
+      std::swap(allocator_, other.allocator_);
+    }
+  }
+
+  // duplicates stay in other, everything else is moved here
+  void merge(tree_type& other) {
+    if (this == &other || other.empty()) return;
+    tree_type rest(other.get_allocator());
+    reserve(size_ + other.size_);
+    for (iterator it = other.begin(); it != other.end(); ++it) {
+      if (!EmplaceUnique(key_of_(*it), std::move(*it)).second) {
+        rest.EmplaceUnique(key_of_(*it), std::move(*it));
+      }
+    }
+    other.clear();
+    other.swap(rest);
+  }
+
+  // set algebra by single lookups, erasing keeps the other indices valid
+  void unite(const tree_type& other) {
+    if (this == &other) return;
+    for (const_iterator it = other.begin(); it != other.end(); ++it) {
+      EmplaceUnique(key_of_(*it), *it);
+    }
+  }
+
+  void intersect(const tree_type& other) {
+    if (this == &other) return;
+    for (iterator it = begin(); it != end();) {
+      iterator next = std::next(it);
+      if (!other.contains(key_of_(*it))) erase(it);
+      it = next;
+    }
+  }
+
+  void subtract(const tree_type& other) {
+    if (this == &other) {
+      clear();
+      return;
+    }
+    for (iterator it = begin(); it != end();) {
+      iterator next = std::next(it);
+      if (other.contains(key_of_(*it))) erase(it);
+      it = next;
+    }
+  }
+
+  /*
+  replaces the contents with [first, last), which must be sorted and free
+  of duplicates, in O(n): the values take the slots 1..n in order and are
+  hung as a perfectly balanced tree whose deepest level is red
+  */
+  template <class ForwardIt>
+  void BuildSorted(ForwardIt first, ForwardIt last) {
+    clear();
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    if (count == 0) return;
+    reserve(count);
+    index_type index = 1;
+    try {
+      for (; first != last; ++first, ++index) {
+        ::new (static_cast<void*>(nodes_[index].storage_)) value_type(*first);
+      }
+    } catch (...) {
+      for (index_type built = 1; built < index; ++built) {
+        ValueAt(built).~value_type();
+      }
+      throw;
+    }
+    used_ = static_cast<index_type>(count + 1);
+    size_ = count;
+    size_type height = 0;
+    for (size_type n = count; n != 0; n /= 2) ++height;
+    root_ = BuildBranch(1, count, 0, height - 1);
+    nodes_[root_].parent_ = kNil;
+  }
+
+  const Compare& key_comp() const noexcept { return is_less_; }
+
+  // the slot goes to the free list, iterators to other values stay valid
+  void erase(iterator pos) noexcept {
+    if (pos.index_ == kNil) return;
+    EraseNode(pos.index_);
+    ValueAt(pos.index_).~value_type();
+    nodes_[pos.index_].parent_ = kFreeSlot;
+    nodes_[pos.index_].left_ = free_;
+    free_ = pos.index_;
+    --size_;
+  }
+
+  // moves the value at pos out of the tree as T and frees its slot
+  template <class T>
+  T Extract(iterator pos) {
+    T value(MoveOutOfSlot(ValueAt(pos.index_)));
+    erase(pos);
+    return value;
+  }
+
+  class ArenaTreeIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    ArenaTreeIterator() = delete;
+    ArenaTreeIterator(tree_type* tree, index_type index)
+        : tree_(tree), index_(index) {}
+
+    iterator& operator++() noexcept {
+      index_ = tree_->NextNode(index_);
+      return *this;
+    }
+
+    iterator& operator--() noexcept {
+      index_ = tree_->PrevNode(index_);
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator tmp{*this};
+      ++*this;
+      return tmp;
+    }
+
+    iterator operator--(int) noexcept {
+      iterator tmp{*this};
+      --*this;
+      return tmp;
+    }
+
+    reference operator*() const noexcept { return tree_->ValueAt(index_); }
+
+    bool operator==(const iterator& o) const noexcept {
+      return tree_ == o.tree_ && index_ == o.index_;
+    }
+
+    bool operator!=(const iterator& o) const noexcept { return !(*this == o); }
+
+    tree_type* tree_;
+    index_type index_;
+  };
+
+  class ArenaTreeConstIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value*;
+    using reference = const Value&;
+
+    ArenaTreeConstIterator() = delete;
+    ArenaTreeConstIterator(const iterator& o) : it_(o) {}
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+
+    const_iterator& operator--() noexcept {
+      --it_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator tmp{*this};
+      ++it_;
+      return tmp;
+    }
+
+    const_iterator operator--(int) noexcept {
+      const_iterator tmp{*this};
+      --it_;
+      return tmp;
+    }
+
+    const_reference operator*() const noexcept { return *it_; }
+
+    friend bool operator==(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ == it2.it_;
+    }
+
+    friend bool operator!=(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ != it2.it_;
+    }
+
+   private:
+    iterator it_;
+  };
+
+ private:
+  // HELPERS
+  value_type& ValueAt(index_type index) const noexcept {
+    return *std::launder(
+        reinterpret_cast<value_type*>(nodes_[index].storage_));
+  }
+
+  decltype(auto) KeyAt(index_type index) const noexcept {
+    return key_of_(ValueAt(index));
+  }
+
+  index_type Parent(index_type node) const noexcept {
+    return nodes_[node].parent_ & ~kRedBit;
+  }
+
+  void SetParent(index_type node, index_type parent) noexcept {
+    nodes_[node].parent_ = (nodes_[node].parent_ & kRedBit) | parent;
+  }
+
+  bool IsRed(index_type node) const noexcept {
+    return nodes_[node].parent_ & kRedBit;
+  }
+
+  void SetRed(index_type node, bool red) noexcept {
+    nodes_[node].parent_ = Parent(node) | (red ? kRedBit : 0);
+  }
+
+  index_type MostLeft(index_type node) const noexcept {
+    while (nodes_[node].left_ != kNil) node = nodes_[node].left_;
+    return node;
+  }
+
+  index_type MostRight(index_type node) const noexcept {
+    while (nodes_[node].right_ != kNil) node = nodes_[node].right_;
+    return node;
+  }
+
+  index_type NextNode(index_type node) const noexcept {
+    if (nodes_[node].right_ != kNil) return MostLeft(nodes_[node].right_);
+    index_type parent = Parent(node);
+    while (parent != kNil && node == nodes_[parent].right_) {
+      node = parent;
+      parent = Parent(node);
+    }
+    return parent;
+  }
+
+  // the nil steps back to the maximum
+  index_type PrevNode(index_type node) const noexcept {
+    if (node == kNil) return root_ == kNil ? kNil : MostRight(root_);
+    if (nodes_[node].left_ != kNil) return MostRight(nodes_[node].left_);
+    index_type parent = Parent(node);
+    while (parent != kNil && node == nodes_[parent].left_) {
+      node = parent;
+      parent = Parent(node);
+    }
+    return parent;
+  }
+
+  /*
+  a red node with the value built from args, from the free list or the
+  end of the arena; when the arena is full the value is built in the new
+  one first, as args may refer to values of the old one
+  */
+  template <class... Args>
+  index_type NewNode(Args&&... args) {
+    index_type index = free_;
+    if (index != kNil) {
+      ::new (static_cast<void*>(nodes_[index].storage_))
+          value_type(std::forward<Args>(args)...);
+      free_ = nodes_[index].left_;
+    } else if (used_ < capacity_) {
+      index = used_;
+      ::new (static_cast<void*>(nodes_[index].storage_))
+          value_type(std::forward<Args>(args)...);
+      ++used_;
+    } else {
+      if (capacity_ > kMaxNodes) {
+        throw std::length_error("value exceeds maximum size");
+      }
+      size_type capacity = std::min(std::max(kMinCapacity, 2 * capacity_),
+                                    kMaxNodes + 1);
+      Node* arena = node_traits::allocate(allocator_, capacity);
+      index = used_;
+      try {
+        ::new (static_cast<void*>(arena[index].storage_))
+            value_type(std::forward<Args>(args)...);
+      } catch (...) {
+        node_traits::deallocate(allocator_, arena, capacity);
+        throw;
+      }
+      try {
+        Relocate(arena);
+      } catch (...) {
+        std::launder(reinterpret_cast<value_type*>(arena[index].storage_))
+            ->~value_type();
+        node_traits::deallocate(allocator_, arena, capacity);
+        throw;
+      }
+      ReleaseArena();
+      nodes_ = arena;
+      capacity_ = capacity;
+      ++used_;
+    }
+    nodes_[index].parent_ = kRedBit;
+    nodes_[index].left_ = kNil;
+    nodes_[index].right_ = kNil;
+    return index;
+  }
+
+  /*
+  moves the used slots into arena; the links are indices and are copied
+  as they are, trivially relocatable values go along with their bytes
+  */
+  void Relocate(Node* arena) {
+    if (nodes_ == nullptr) {
+      arena[kNil].parent_ = kNil;
+      arena[kNil].left_ = kNil;
+      arena[kNil].right_ = kNil;
+      return;
+    }
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      std::memcpy(static_cast<void*>(arena), nodes_, used_ * sizeof(Node));
+    } else {
+      index_type index = 0;
+      try {
+        for (; index < used_; ++index) {
+          arena[index].parent_ = nodes_[index].parent_;
+          arena[index].left_ = nodes_[index].left_;
+          arena[index].right_ = nodes_[index].right_;
+          if (index != kNil && nodes_[index].parent_ != kFreeSlot) {
+            ::new (static_cast<void*>(arena[index].storage_))
+                value_type(std::move_if_noexcept(ValueAt(index)));
+          }
+        }
+      } catch (...) {
+        for (index_type built = 1; built < index; ++built) {
+          if (arena[built].parent_ != kFreeSlot) {
+            std::launder(reinterpret_cast<value_type*>(arena[built].storage_))
+                ->~value_type();
+          }
+        }
+        throw;
+      }
+      for (index = 1; index < used_; ++index) {
+        if (nodes_[index].parent_ != kFreeSlot) ValueAt(index).~value_type();
+      }
+    }
+  }
+
+  void ReleaseArena() noexcept {
+    if (nodes_ != nullptr) {
+      node_traits::deallocate(allocator_, nodes_, capacity_);
+    }
+    nodes_ = nullptr;
+    capacity_ = 0;
+  }
+
+  // a trivially copyable tree is copied slot for slot, others are rebuilt
+  void CopyTree(const tree_type& other) {
+    clear();
+    is_less_ = other.is_less_;
+    key_of_ = other.key_of_;
+    if (other.root_ == kNil) return;
+    if constexpr (kBitwiseCopy) {
+      reserve(other.used_ - 1);
+      std::memcpy(static_cast<void*>(nodes_), other.nodes_,
+                  other.used_ * sizeof(Node));
+      used_ = other.used_;
+      free_ = other.free_;
+      root_ = other.root_;
+      size_ = other.size_;
+    } else {
+      BuildSorted(other.begin(), other.end());
+    }
+  }
+
+  // subtree of the count slots from first, which already hold their values
+  index_type BuildBranch(index_type first, size_type count, size_type depth,
+                         size_type red_depth) noexcept {
+    if (count == 0) return kNil;
+    index_type node = first + static_cast<index_type>(count / 2);
+    index_type left = BuildBranch(first, count / 2, depth + 1, red_depth);
+    index_type right =
+        BuildBranch(node + 1, count - count / 2 - 1, depth + 1, red_depth);
+    nodes_[node].left_ = left;
+    nodes_[node].right_ = right;
+    nodes_[node].parent_ = depth != 0 && depth == red_depth ? kRedBit : 0;
+    if (left != kNil) SetParent(left, node);
+    if (right != kNil) SetParent(right, node);
+    return node;
+  }
+
+  void LinkNode(index_type node, index_type parent, bool left) noexcept {
+    SetParent(node, parent);
+    if (parent == kNil) {
+      root_ = node;
+    } else if (left) {
+      nodes_[parent].left_ = node;
+    } else {
+      nodes_[parent].right_ = node;
+    }
+    ++size_;
+    FixInsert(node);
+  }
+
+  void FixInsert(index_type node) noexcept {
+    while (IsRed(Parent(node))) {
+      index_type parent = Parent(node);
+      index_type grandparent = Parent(parent);
+      bool left = parent == nodes_[grandparent].left_;
+      index_type uncle =
+          left ? nodes_[grandparent].right_ : nodes_[grandparent].left_;
+      if (IsRed(uncle)) {
+        SetRed(parent, false);
+        SetRed(uncle, false);
+        SetRed(grandparent, true);
+        node = grandparent;
+        continue;
+      }
+      if (node == (left ? nodes_[parent].right_ : nodes_[parent].left_)) {
+        node = parent;
+        left ? RotateLeft(node) : RotateRight(node);
+        parent = Parent(node);
+      }
+      SetRed(parent, false);
+      SetRed(grandparent, true);
+      left ? RotateRight(grandparent) : RotateLeft(grandparent);
+    }
+    SetRed(root_, false);
+  }
+
+  // puts replacement where node hangs; replacement may be the nil
+  void Transplant(index_type node, index_type replacement) noexcept {
+    index_type parent = Parent(node);
+    if (parent == kNil) {
+      root_ = replacement;
+    } else if (node == nodes_[parent].left_) {
+      nodes_[parent].left_ = replacement;
+    } else {
+      nodes_[parent].right_ = replacement;
+    }
+    SetParent(replacement, parent);
+  }
+
+  // unlinks node; the nil may take a parent while the tree is rebalanced
+  void EraseNode(index_type node) noexcept {
+    index_type moved = node;
+    bool removed_red = IsRed(moved);
+    index_type child = kNil;
+    if (nodes_[node].left_ == kNil) {
+      child = nodes_[node].right_;
+      Transplant(node, child);
+    } else if (nodes_[node].right_ == kNil) {
+      child = nodes_[node].left_;
+      Transplant(node, child);
+    } else {
+      moved = MostLeft(nodes_[node].right_);
+      removed_red = IsRed(moved);
+      child = nodes_[moved].right_;
+      if (Parent(moved) == node) {
+        SetParent(child, moved);
+      } else {
+        Transplant(moved, child);
+        nodes_[moved].right_ = nodes_[node].right_;
+        SetParent(nodes_[moved].right_, moved);
+      }
+      Transplant(node, moved);
+      nodes_[moved].left_ = nodes_[node].left_;
+      SetParent(nodes_[moved].left_, moved);
+      SetRed(moved, IsRed(node));
+    }
+    if (!removed_red) FixErase(child);
+    SetParent(kNil, kNil);
+  }
+
+  void FixErase(index_type node) noexcept {
+    while (node != root_ && !IsRed(node)) {
+      index_type parent = Parent(node);
+      bool left = node == nodes_[parent].left_;
+      index_type sibling = left ? nodes_[parent].right_ : nodes_[parent].left_;
+      if (IsRed(sibling)) {
+        SetRed(sibling, false);
+        SetRed(parent, true);
+        left ? RotateLeft(parent) : RotateRight(parent);
+        sibling = left ? nodes_[parent].right_ : nodes_[parent].left_;
+      }
+      index_type near = left ? nodes_[sibling].left_ : nodes_[sibling].right_;
+      index_type far = left ? nodes_[sibling].right_ : nodes_[sibling].left_;
+      if (!IsRed(near) && !IsRed(far)) {
+        SetRed(sibling, true);
+        node = parent;
+        continue;
+      }
+      if (!IsRed(far)) {
+        SetRed(near, false);
+        SetRed(sibling, true);
+        left ? RotateRight(sibling) : RotateLeft(sibling);
+        sibling = left ? nodes_[parent].right_ : nodes_[parent].left_;
+        far = left ? nodes_[sibling].right_ : nodes_[sibling].left_;
+      }
+      SetRed(sibling, IsRed(parent));
+      SetRed(parent, false);
+      SetRed(far, false);
+      left ? RotateLeft(parent) : RotateRight(parent);
+      node = root_;
+    }
+    if (node != kNil) SetRed(node, false);
+  }
+
+  void RotateLeft(index_type node) noexcept {
+    index_type pivot = nodes_[node].right_;
+    nodes_[node].right_ = nodes_[pivot].left_;
+    if (nodes_[pivot].left_ != kNil) SetParent(nodes_[pivot].left_, node);
+    Transplant(node, pivot);
+    nodes_[pivot].left_ = node;
+    SetParent(node, pivot);
+  }
+
+  void RotateRight(index_type node) noexcept {
+    index_type pivot = nodes_[node].left_;
+    nodes_[node].left_ = nodes_[pivot].right_;
+    if (nodes_[pivot].right_ != kNil) SetParent(nodes_[pivot].right_, node);
+    Transplant(node, pivot);
+    nodes_[pivot].right_ = node;
+    SetParent(node, pivot);
+  }
+
+  Node* nodes_;
+  size_type capacity_;
+  index_type used_;
+  index_type free_;
+  index_type root_;
+  size_type size_;
+  Compare is_less_;
+  KeyOfValue key_of_;
+  [[no_unique_address]] node_allocator_type allocator_;
+};
+
+/*
+arena tree backend for s21::map and s21::Set: red-black nodes of three
+32-bit links and the value in one relocatable array; swap and move
+invalidate its iterators (see ArenaTree)
+*/
+struct ArenaTreeBackend {
+  template <class Key, class Value, class KeyOfValue, class Compare,
+            class Allocator>
+  using tree_type = ArenaTree<Key, Value, KeyOfValue, Compare, Allocator>;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_ARENA_TREE_H_
@@ -0,0 +1,1088 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_BPLUSTREE_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_BPLUSTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../containers/s21_vector.h"
+
+namespace s21 {
+
+// relocating T (see BPlusTree::Relocate) never throws
+template <class T>
+struct IsNothrowRelocatable
+    : std::disjunction<is_trivially_relocatable<T>,
+                       std::is_nothrow_move_constructible<T>> {};
+
+template <class First, class Second>
+struct IsNothrowRelocatable<std::pair<const First, Second>>
+    : std::disjunction<
+          is_trivially_relocatable<std::pair<const First, Second>>,
+          std::conjunction<std::is_nothrow_move_constructible<First>,
+                           std::is_nothrow_move_constructible<Second>>> {};
+
+/*
+B+ tree with wide nodes
+values are stored contiguously in leaves, leaves form a doubly linked list,
+inner nodes hold only separator keys and child pointers
+
+unlike RedBlackTree, insert and erase shift values inside a leaf, so they
+invalidate iterators (except the ones they return)
+
+leaves and inner nodes come from Allocator rebound to each node type
+
+shifts move values and keys, the const keys of map values included; if
+such a move can throw, a throw in the middle of a shift leaves the tree
+in an unspecified state that may only be destroyed
+*/
+template <class Key, class Value, class KeyOfValue, class Compare,
+          class Allocator = std::allocator<Value>>
+class BPlusTree {
+ public:
+  class BPlusTreeIterator;
+  class BPlusTreeConstIterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = BPlusTreeIterator;
+  using const_iterator = BPlusTreeConstIterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using tree_type = BPlusTree<Key, Value, KeyOfValue, Compare, Allocator>;
+
+  // target node size: a few cache lines per node
+  static constexpr size_type kNodeBytes = 512;
+
+ private:
+  struct Node {
+    size_type count_;
+  };
+
+  // slots of the given size that fit into a node, one of them kept spare
+  static constexpr size_type NodeCapacity(size_type header,
+                                          size_type slot) noexcept {
+    return header + 5 * slot > kNodeBytes ? 4
+                                          : (kNodeBytes - header) / slot - 1;
+  }
+
+ public:
+  static constexpr size_type kLeafCapacity =
+      NodeCapacity(sizeof(Node) + 2 * sizeof(void*), sizeof(value_type));
+  static constexpr size_type kInnerCapacity = NodeCapacity(
+      sizeof(Node) + sizeof(void*), sizeof(key_type) + sizeof(void*));
+
+ private:
+  static constexpr size_type kLeafMin = kLeafCapacity / 2;
+  static constexpr size_type kInnerMin = kInnerCapacity / 2;
+  static constexpr size_type kMaxHeight = 64;
+
+  // the spare slot lets a node be split after the insertion
+  struct LeafNode : Node {
+    LeafNode* prev_;
+    LeafNode* next_;
+    alignas(value_type) unsigned char storage_[(kLeafCapacity + 1) *
+                                               sizeof(value_type)];
+
+    value_type* values() noexcept {
+      return std::launder(reinterpret_cast<value_type*>(storage_));
+    }
+  };
+
+  struct InnerNode : Node {
+    Node* children_[kInnerCapacity + 2];
+    alignas(key_type) unsigned char storage_[(kInnerCapacity + 1) *
+                                             sizeof(key_type)];
+
+    key_type* keys() noexcept {
+      return std::launder(reinterpret_cast<key_type*>(storage_));
+    }
+  };
+
+  struct PathStep {
+    InnerNode* node_;
+    size_type index_;
+  };
+
+ private:
+  using alloc_traits = std::allocator_traits<allocator_type>;
+  using leaf_allocator_type =
+      typename alloc_traits::template rebind_alloc<LeafNode>;
+  using inner_allocator_type =
+      typename alloc_traits::template rebind_alloc<InnerNode>;
+  using node_array_allocator_type =
+      typename alloc_traits::template rebind_alloc<Node*>;
+  using leaf_traits = std::allocator_traits<leaf_allocator_type>;
+  using inner_traits = std::allocator_traits<inner_allocator_type>;
+  using node_array_traits = std::allocator_traits<node_array_allocator_type>;
+
+ public:
+  BPlusTree() : BPlusTree(Compare(), allocator_type()) {}
+
+  explicit BPlusTree(const allocator_type& alloc)
+      : BPlusTree(Compare(), alloc) {}
+
+  explicit BPlusTree(const Compare& comp,
+                     const allocator_type& alloc = allocator_type())
+      : root_(nullptr),
+        first_(nullptr),
+        last_(nullptr),
+        height_(size_type{}),
+        size_(size_type{}),
+        is_less_(comp),
+        leaf_allocator_(alloc),
+        inner_allocator_(alloc) {}
+
+  BPlusTree(const tree_type& other)
+      : BPlusTree(alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())) {
+    CopyTree(other);
+  }
+
+  BPlusTree(tree_type&& other) noexcept : BPlusTree(other.get_allocator()) {
+    swap(other);
+  }
+
+  tree_type& operator=(const tree_type& other) {
+    if (this != &other) {
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (get_allocator() != other.get_allocator()) {
+          clear();
+          leaf_allocator_ = other.leaf_allocator_;
+          inner_allocator_ = other.inner_allocator_;
+        }
+      }
+      CopyTree(other);
+    }
+    return *this;
+  }
+
+  // values are moved one by one only if the nodes of other cannot be stolen
+  tree_type& operator=(tree_type&& other) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::
+                      value &&
+                  !alloc_traits::is_always_equal::value) {
+      if (get_allocator() != other.get_allocator()) {
+        is_less_ = other.is_less_;
+        key_of_ = other.key_of_;
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+          InsertValue(std::move(*it));
+        }
+        other.clear();
+        return *this;
+      }
+    }
+    swap(other);
+    return *this;
+  }
+
+  ~BPlusTree() { clear(); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(leaf_allocator_);
+  }
+
+  void clear() noexcept {
+    if (root_ != nullptr) DeleteBranch(root_, height_);
+    root_ = nullptr;
+    first_ = nullptr;
+    last_ = nullptr;
+    height_ = 0;
+    size_ = 0;
+  }
+
+  /*
+  nodes are allocated one at a time as the tree grows, so there is
+  nothing to set aside; kept for the interface of map and Set
+  */
+  void reserve(size_type) noexcept {}
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / 2 / sizeof(value_type);
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return InsertValue(value);
+  }
+
+  // values live inside the leaves, so the key is taken from a temporary
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return InsertValue(value_type(std::forward<Args>(args)...));
+  }
+
+  /*
+  one descent: returns the value equal to key or builds one from args in
+  the slot where the search ended
+  */
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceUnique(const K& key, Args&&... args) {
+    if (root_ == nullptr) {
+      LeafNode* leaf = NewLeaf();
+      try {
+        ::new (static_cast<void*>(leaf->values()))
+            value_type(std::forward<Args>(args)...);
+      } catch (...) {
+        DeleteLeaf(leaf);
+        throw;
+      }
+      leaf->count_ = 1;
+      root_ = first_ = last_ = leaf;
+      size_ = 1;
+      return {iterator(leaf, 0), true};
+    }
+
+    PathStep path[kMaxHeight];
+    LeafNode* leaf = FindLeaf(key, path);
+    size_type index = LowerBound(leaf, key);
+    if (index < leaf->count_ &&
+        !is_less_(key, key_of_(leaf->values()[index]))) {
+      return {iterator(leaf, index), false};
+    }
+
+    ConstructAt(leaf, index, std::forward<Args>(args)...);
+    if (leaf->count_ <= kLeafCapacity) return {iterator(leaf, index), true};
+    return {SplitLeaf(leaf, index, path), true};
+  }
+
+  /*
+  EmplaceUnique that first tries the position of hint: if key falls
+  between the value before hint in the same leaf and hint itself (end()
+  included), it is put there without a descent; the path from the root
+  is only looked up when the leaf has to be split
+  */
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceHint(iterator hint, const K& key,
+                                        Args&&... args) {
+    LeafNode* leaf = hint.leaf_;
+    size_type index = hint.index_;
+    if (leaf == nullptr || index == 0 ||
+        !is_less_(key_of_(leaf->values()[index - 1]), key) ||
+        (index < leaf->count_ &&
+         !is_less_(key, key_of_(leaf->values()[index])))) {
+      return EmplaceUnique(key, std::forward<Args>(args)...);
+    }
+
+    ConstructAt(leaf, index, std::forward<Args>(args)...);
+    if (leaf->count_ <= kLeafCapacity) return {iterator(leaf, index), true};
+    PathStep path[kMaxHeight];
+    FindLeaf(key_of_(leaf->values()[index]), path);
+    return {SplitLeaf(leaf, index, path), true};
+  }
+
+  iterator begin() noexcept { return iterator(first_, 0); }
+
+  iterator end() noexcept {
+    return iterator(last_, last_ == nullptr ? 0 : last_->count_);
+  }
+
+  const_iterator begin() const noexcept { return const_iterator(first_, 0); }
+
+  const_iterator end() const noexcept {
+    return const_iterator(last_, last_ == nullptr ? 0 : last_->count_);
+  }
+
+  /*
+  return iterator on end if not found
+  else returns iterator on the value with the given key;
+  key may be of any type Compare can order against key_type
+  */
+  template <class K>
+  iterator find(const K& key) const noexcept {
+    if (root_ == nullptr) return const_cast<tree_type*>(this)->end();
+    LeafNode* leaf = FindLeaf(key, nullptr);
+    size_type index = LowerBound(leaf, key);
+    if (index < leaf->count_ &&
+        !is_less_(key, key_of_(leaf->values()[index]))) {
+      return iterator(leaf, index);
+    }
+    return const_cast<tree_type*>(this)->end();
+  }
+
+  template <class K>
+  bool contains(const K& key) const noexcept {
+    iterator it = find(key);
+    return it.leaf_ != nullptr && it.index_ < it.leaf_->count_;
+  }
+
+  // first value not less than key, end() if there is none
+  template <class K>
+  iterator lower_bound(const K& key) const noexcept {
+    if (root_ == nullptr) return const_cast<tree_type*>(this)->end();
+    LeafNode* leaf = FindLeaf(key, nullptr);
+    return NormalizedIterator(leaf, LowerBound(leaf, key));
+  }
+
+  // first value greater than key, end() if there is none
+  template <class K>
+  iterator upper_bound(const K& key) const noexcept {
+    if (root_ == nullptr) return const_cast<tree_type*>(this)->end();
+    LeafNode* leaf = FindLeaf(key, nullptr);
+    return NormalizedIterator(leaf, UpperBound(leaf, key));
+  }
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    iterator first = lower_bound(key);
+    iterator last = first;
+    if (first.leaf_ != nullptr && first.index_ < first.leaf_->count_ &&
+        !is_less_(key, key_of_(*first))) {
+      ++last;
+    }
+    return {first, last};
+  }
+
+  void swap(tree_type& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(height_, other.height_);
+    std::swap(size_, other.size_);
+    std::swap(is_less_, other.is_less_);
+    std::swap(key_of_, other.key_of_);
+    // the move assignment steals nodes through swap too
+    if constexpr (alloc_traits::propagate_on_container_swap::value ||
+                  alloc_traits::propagate_on_container_move_assignment::
+                      value) {
+      std::swap(leaf_allocator_, other.leaf_allocator_);
+      std::swap(inner_allocator_, other.inner_allocator_);
+    }
+  }
+
+  /*
+  values whose keys are missing here are moved over one at a time and
+  erased from other; duplicates are left untouched, and if an insertion
+  throws only the value being moved is affected
+  */
+  void merge(tree_type& other) {
+    if (this == &other) return;
+    for (iterator it = other.begin(); it != other.end();) {
+      if (EmplaceUnique(key_of_(*it), std::move(*it)).second) {
+        it = other.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // set algebra by single lookups; values shift in leaves, there is no join
+  void unite(const tree_type& other) {
+    if (this == &other) return;
+    for (const_iterator it = other.begin(); it != other.end(); ++it) {
+      InsertValue(*it);
+    }
+  }
+
+  void intersect(const tree_type& other) {
+    if (this == &other) return;
+    for (iterator it = begin(); it != end();) {
+      it = other.contains(key_of_(*it)) ? std::next(it) : erase(it);
+    }
+  }
+
+  void subtract(const tree_type& other) {
+    if (this == &other) {
+      clear();
+      return;
+    }
+    for (iterator it = begin(); it != end();) {
+      it = other.contains(key_of_(*it)) ? erase(it) : std::next(it);
+    }
+  }
+
+  /*
+  replaces the contents with [first, last), which must be sorted and free
+  of duplicates, in O(n): the values are spread evenly over as few leaves
+  as possible, then every level of inner nodes is built over the one below
+  */
+  template <class ForwardIt>
+  void BuildSorted(ForwardIt first, ForwardIt last) {
+    clear();
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    if (count == 0) return;
+    size_type width = (count + kLeafCapacity - 1) / kLeafCapacity;
+    node_array_allocator_type array_allocator(leaf_allocator_);
+    Node** nodes = node_array_traits::allocate(array_allocator, width);
+    size_type leaves = width;
+    try {
+      BuildLeaves(first, count, nodes, width);
+      while (width > 1) width = BuildInnerLevel(nodes, width);
+    } catch (...) {
+      node_array_traits::deallocate(array_allocator, nodes, leaves);
+      throw;
+    }
+    root_ = nodes[0];
+    size_ = count;
+    node_array_traits::deallocate(array_allocator, nodes, leaves);
+  }
+
+  const Compare& key_comp() const noexcept { return is_less_; }
+
+  // returns iterator on the value that followed the erased one
+  iterator erase(iterator pos) {
+    if (pos.leaf_ == nullptr || pos.index_ >= pos.leaf_->count_) return pos;
+    PathStep path[kMaxHeight];
+    LeafNode* leaf = FindLeaf(key_of_(pos.leaf_->values()[pos.index_]), path);
+    return EraseAt(leaf, pos.index_, path);
+  }
+
+  // moves the value at pos out of the tree as T and erases its slot
+  template <class T>
+  T Extract(iterator pos) {
+    PathStep path[kMaxHeight];
+    LeafNode* leaf = FindLeaf(key_of_(pos.leaf_->values()[pos.index_]), path);
+    T value(MoveOutOfSlot(leaf->values()[pos.index_]));
+    EraseAt(leaf, pos.index_, path);
+    return value;
+  }
+
+  class BPlusTreeIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    BPlusTreeIterator() = delete;
+    BPlusTreeIterator(LeafNode* leaf, size_type index)
+        : leaf_(leaf), index_(index) {}
+
+    iterator& operator++() noexcept {
+      if (++index_ == leaf_->count_ && leaf_->next_ != nullptr) {
+        leaf_ = leaf_->next_;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    iterator& operator--() noexcept {
+      if (index_ == 0) {
+        leaf_ = leaf_->prev_;
+        index_ = leaf_->count_;
+      }
+      --index_;
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator tmp{*this};
+      ++*this;
+      return tmp;
+    }
+
+    iterator operator--(int) noexcept {
+      iterator tmp{*this};
+      --*this;
+      return tmp;
+    }
+
+    reference operator*() const noexcept { return leaf_->values()[index_]; }
+
+    bool operator==(const iterator& o) const noexcept {
+      return leaf_ == o.leaf_ && index_ == o.index_;
+    }
+
+    bool operator!=(const iterator& o) const noexcept { return !(*this == o); }
+
+    LeafNode* leaf_;
+    size_type index_;
+  };
+
+  class BPlusTreeConstIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value*;
+    using reference = const Value&;
+
+    BPlusTreeConstIterator() = delete;
+    BPlusTreeConstIterator(const LeafNode* leaf, size_type index)
+        : it_(const_cast<LeafNode*>(leaf), index) {}
+    BPlusTreeConstIterator(const iterator& o) : it_(o) {}
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+
+    const_iterator& operator--() noexcept {
+      --it_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator tmp{*this};
+      ++it_;
+      return tmp;
+    }
+
+    const_iterator operator--(int) noexcept {
+      const_iterator tmp{*this};
+      --it_;
+      return tmp;
+    }
+
+    const_reference operator*() const noexcept { return *it_; }
+
+    friend bool operator==(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ == it2.it_;
+    }
+
+    friend bool operator!=(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ != it2.it_;
+    }
+
+   private:
+    iterator it_;
+  };
+
+ private:
+  // HELPERS
+  template <class V>
+  std::pair<iterator, bool> InsertValue(V&& value) {
+    return EmplaceUnique(key_of_(value), std::forward<V>(value));
+  }
+
+  // opens a slot at index and builds the value there
+  template <class... Args>
+  void ConstructAt(LeafNode* leaf, size_type index, Args&&... args) {
+    value_type* values = leaf->values();
+    RelocateValues(values + index + 1, values + index, leaf->count_ - index);
+    try {
+      ::new (static_cast<void*>(values + index))
+          value_type(std::forward<Args>(args)...);
+    } catch (...) {
+      RelocateValues(values + index, values + index + 1, leaf->count_ - index);
+      throw;
+    }
+    ++leaf->count_;
+    ++size_;
+  }
+
+  // an overflowing leaf is split in half, the separator goes to the parent
+  iterator SplitLeaf(LeafNode* leaf, size_type index, PathStep* path) {
+    LeafNode* right = NewLeaf();
+    size_type left_count = leaf->count_ / 2;
+    right->count_ = leaf->count_ - left_count;
+    RelocateValues(right->values(), leaf->values() + left_count,
+                   right->count_);
+    leaf->count_ = left_count;
+
+    right->prev_ = leaf;
+    right->next_ = leaf->next_;
+    if (leaf->next_ != nullptr) {
+      leaf->next_->prev_ = right;
+    } else {
+      last_ = right;
+    }
+    leaf->next_ = right;
+
+    InsertIntoParent(path, height_, key_of_(right->values()[0]), right);
+    if (index < left_count) return iterator(leaf, index);
+    return iterator(right, index - left_count);
+  }
+
+  void InsertIntoParent(PathStep* path, size_type depth, const key_type& key,
+                        Node* right) {
+    if (depth == 0) {
+      InnerNode* root = NewInner();
+      ::new (static_cast<void*>(root->keys())) key_type(key);
+      root->children_[0] = root_;
+      root->children_[1] = right;
+      root->count_ = 1;
+      root_ = root;
+      ++height_;
+      return;
+    }
+
+    InnerNode* node = path[depth - 1].node_;
+    size_type index = path[depth - 1].index_;
+    key_type* keys = node->keys();
+    RelocateKeys(keys + index + 1, keys + index, node->count_ - index);
+    ::new (static_cast<void*>(keys + index)) key_type(key);
+    std::copy_backward(node->children_ + index + 1,
+                       node->children_ + node->count_ + 1,
+                       node->children_ + node->count_ + 2);
+    node->children_[index + 1] = right;
+    ++node->count_;
+    if (node->count_ <= kInnerCapacity) return;
+
+    // the middle key moves up, the right half goes to a new node
+    InnerNode* sibling = NewInner();
+    size_type middle = node->count_ / 2;
+    sibling->count_ = node->count_ - middle - 1;
+    RelocateKeys(sibling->keys(), keys + middle + 1, sibling->count_);
+    std::copy(node->children_ + middle + 1,
+              node->children_ + node->count_ + 1, sibling->children_);
+    node->count_ = middle;
+    InsertIntoParent(path, depth - 1, keys[middle], sibling);
+    keys[middle].~key_type();
+  }
+
+  // leaf that should hold key; the path from the root is saved into path
+  template <class K>
+  LeafNode* FindLeaf(const K& key, PathStep* path) const noexcept {
+    Node* node = root_;
+    for (size_type level = 0; level < height_; ++level) {
+      InnerNode* inner = static_cast<InnerNode*>(node);
+      key_type* keys = inner->keys();
+      size_type index =
+          std::upper_bound(keys, keys + inner->count_, key, is_less_) - keys;
+      if (path != nullptr) path[level] = PathStep{inner, index};
+      node = inner->children_[index];
+    }
+    return static_cast<LeafNode*>(node);
+  }
+
+  template <class K>
+  size_type LowerBound(LeafNode* leaf, const K& key) const noexcept {
+    size_type low = 0, high = leaf->count_;
+    value_type* values = leaf->values();
+    while (low < high) {
+      size_type middle = (low + high) / 2;
+      if (is_less_(key_of_(values[middle]), key)) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  template <class K>
+  size_type UpperBound(LeafNode* leaf, const K& key) const noexcept {
+    size_type low = 0, high = leaf->count_;
+    value_type* values = leaf->values();
+    while (low < high) {
+      size_type middle = (low + high) / 2;
+      if (is_less_(key, key_of_(values[middle]))) {
+        high = middle;
+      } else {
+        low = middle + 1;
+      }
+    }
+    return low;
+  }
+
+  iterator EraseAt(LeafNode* leaf, size_type index, PathStep* path) {
+    value_type* values = leaf->values();
+    EraseValues(values + index, 1);
+    RelocateValues(values + index, values + index + 1,
+                   leaf->count_ - index - 1);
+    leaf->count_ -= 1;
+    --size_;
+    return FixLeaf(leaf, index, path);
+  }
+
+  /*
+  leaf after its index-th value was erased
+  a leaf that is less than half full borrows a value from a sibling or is
+  merged with it; returns the position of the value that followed the
+  erased one
+  */
+  iterator FixLeaf(LeafNode* leaf, size_type index, PathStep* path) {
+    if (leaf == root_) {
+      if (leaf->count_ == 0) {
+        DeleteLeaf(leaf);
+        root_ = first_ = last_ = nullptr;
+        return end();
+      }
+      return NormalizedIterator(leaf, index);
+    }
+    if (leaf->count_ >= kLeafMin) return NormalizedIterator(leaf, index);
+
+    InnerNode* parent = path[height_ - 1].node_;
+    size_type child = path[height_ - 1].index_;
+    LeafNode* left = child > 0
+                         ? static_cast<LeafNode*>(parent->children_[child - 1])
+                         : nullptr;
+    LeafNode* right =
+        child < parent->count_
+            ? static_cast<LeafNode*>(parent->children_[child + 1])
+            : nullptr;
+
+    if (left != nullptr && left->count_ > kLeafMin) {
+      value_type* values = leaf->values();
+      RelocateValues(values + 1, values, leaf->count_);
+      RelocateValues(values, left->values() + left->count_ - 1, 1);
+      --left->count_;
+      ++leaf->count_;
+      ReplaceKey(parent->keys() + child - 1, key_of_(values[0]));
+      return NormalizedIterator(leaf, index + 1);
+    }
+    if (right != nullptr && right->count_ > kLeafMin) {
+      RelocateValues(leaf->values() + leaf->count_, right->values(), 1);
+      RelocateValues(right->values(), right->values() + 1, right->count_ - 1);
+      --right->count_;
+      ++leaf->count_;
+      ReplaceKey(parent->keys() + child, key_of_(right->values()[0]));
+      return NormalizedIterator(leaf, index);
+    }
+
+    iterator next = end();
+    if (left != nullptr) {
+      size_type offset = left->count_;
+      MergeLeaves(left, leaf);
+      RemoveFromInner(parent, child - 1);
+      next = NormalizedIterator(left, offset + index);
+    } else {
+      MergeLeaves(leaf, right);
+      RemoveFromInner(parent, child);
+      next = NormalizedIterator(leaf, index);
+    }
+    FixInner(height_ - 1, path);
+    return next;
+  }
+
+  // values of right move to the end of left, right is deleted
+  void MergeLeaves(LeafNode* left,
+                   LeafNode* right) noexcept(kNothrowValueShift) {
+    RelocateValues(left->values() + left->count_, right->values(),
+                   right->count_);
+    left->count_ += right->count_;
+    right->count_ = 0;
+    left->next_ = right->next_;
+    if (right->next_ != nullptr) {
+      right->next_->prev_ = left;
+    } else {
+      last_ = left;
+    }
+    DeleteLeaf(right);
+  }
+
+  // removes key index together with the child to the right of it
+  void RemoveFromInner(InnerNode* node,
+                       size_type index) noexcept(kNothrowKeyShift) {
+    key_type* keys = node->keys();
+    keys[index].~key_type();
+    RelocateKeys(keys + index, keys + index + 1, node->count_ - index - 1);
+    std::copy(node->children_ + index + 2, node->children_ + node->count_ + 1,
+              node->children_ + index + 1);
+    --node->count_;
+  }
+
+  void FixInner(size_type depth, PathStep* path) {
+    InnerNode* node = path[depth].node_;
+    if (depth == 0) {
+      if (node->count_ == 0) {
+        root_ = node->children_[0];
+        DeleteInner(node);
+        --height_;
+      }
+      return;
+    }
+    if (node->count_ >= kInnerMin) return;
+
+    InnerNode* parent = path[depth - 1].node_;
+    size_type child = path[depth - 1].index_;
+    key_type* parent_keys = parent->keys();
+    key_type* keys = node->keys();
+    InnerNode* left =
+        child > 0 ? static_cast<InnerNode*>(parent->children_[child - 1])
+                  : nullptr;
+    InnerNode* right =
+        child < parent->count_
+            ? static_cast<InnerNode*>(parent->children_[child + 1])
+            : nullptr;
+
+    // rotation through the parent: its key goes down, the sibling's goes up
+    if (left != nullptr && left->count_ > kInnerMin) {
+      RelocateKeys(keys + 1, keys, node->count_);
+      std::copy_backward(node->children_, node->children_ + node->count_ + 1,
+                         node->children_ + node->count_ + 2);
+      ::new (static_cast<void*>(keys)) key_type(parent_keys[child - 1]);
+      node->children_[0] = left->children_[left->count_];
+      ++node->count_;
+      ReplaceKey(parent_keys + child - 1, left->keys()[left->count_ - 1]);
+      left->keys()[left->count_ - 1].~key_type();
+      --left->count_;
+      return;
+    }
+    if (right != nullptr && right->count_ > kInnerMin) {
+      ::new (static_cast<void*>(keys + node->count_))
+          key_type(parent_keys[child]);
+      node->children_[node->count_ + 1] = right->children_[0];
+      ++node->count_;
+      ReplaceKey(parent_keys + child, right->keys()[0]);
+      right->keys()[0].~key_type();
+      RelocateKeys(right->keys(), right->keys() + 1, right->count_ - 1);
+      std::copy(right->children_ + 1, right->children_ + right->count_ + 1,
+                right->children_);
+      --right->count_;
+      return;
+    }
+
+    if (left != nullptr) {
+      MergeInner(left, parent_keys[child - 1], node);
+      RemoveFromInner(parent, child - 1);
+    } else {
+      MergeInner(node, parent_keys[child], right);
+      RemoveFromInner(parent, child);
+    }
+    FixInner(depth - 1, path);
+  }
+
+  void MergeInner(InnerNode* left, const key_type& separator,
+                  InnerNode* right) {
+    key_type* keys = left->keys();
+    ::new (static_cast<void*>(keys + left->count_)) key_type(separator);
+    RelocateKeys(keys + left->count_ + 1, right->keys(), right->count_);
+    std::copy(right->children_, right->children_ + right->count_ + 1,
+              left->children_ + left->count_ + 1);
+    left->count_ += right->count_ + 1;
+    right->count_ = 0;
+    DeleteInner(right);
+  }
+
+  static iterator NormalizedIterator(LeafNode* leaf,
+                                     size_type index) noexcept {
+    if (index == leaf->count_ && leaf->next_ != nullptr) {
+      return iterator(leaf->next_, 0);
+    }
+    return iterator(leaf, index);
+  }
+
+  void ReplaceKey(key_type* slot, const key_type& key) {
+    if (slot == &key) return;
+    slot->~key_type();
+    ::new (static_cast<void*>(slot)) key_type(key);
+  }
+
+  static constexpr bool kNothrowValueShift =
+      IsNothrowRelocatable<value_type>::value;
+  static constexpr bool kNothrowKeyShift =
+      IsNothrowRelocatable<key_type>::value;
+
+  // moves one object into raw storage and ends the source
+  template <class T>
+  static void RelocateOne(T* dst, T* src) noexcept(
+      IsNothrowRelocatable<T>::value) {
+    ::new (static_cast<void*>(dst)) T(MoveOutOfSlot(*src));
+    src->~T();
+  }
+
+  // moves n objects into raw storage, the ranges may overlap
+  template <class T>
+  static void Relocate(T* dst, T* src, size_type n) noexcept(
+      IsNothrowRelocatable<T>::value) {
+    if (n == 0 || dst == src) return;
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void*>(dst), static_cast<const void*>(src),
+                   n * sizeof(T));
+    } else if (dst < src) {
+      for (size_type i = 0; i < n; ++i) RelocateOne(dst + i, src + i);
+    } else {
+      for (size_type i = n; i > 0; --i) RelocateOne(dst + i - 1, src + i - 1);
+    }
+  }
+
+  static void RelocateValues(value_type* dst, value_type* src,
+                             size_type n) noexcept(kNothrowValueShift) {
+    Relocate(dst, src, n);
+  }
+
+  static void RelocateKeys(key_type* dst, key_type* src,
+                           size_type n) noexcept(kNothrowKeyShift) {
+    Relocate(dst, src, n);
+  }
+
+  static void EraseValues(value_type* pos, size_type n) noexcept {
+    std::destroy(pos, pos + n);
+  }
+
+  void CopyTree(const tree_type& other) {
+    clear();
+    is_less_ = other.is_less_;
+    key_of_ = other.key_of_;
+    if (other.root_ == nullptr) return;
+    LeafNode* prev = nullptr;
+    root_ = CopyBranch(other.root_, other.height_, prev);
+    last_ = prev;
+    height_ = other.height_;
+    size_ = other.size_;
+  }
+
+  Node* CopyBranch(Node* node, size_type level, LeafNode*& prev) {
+    if (level == 0) {
+      LeafNode* source = static_cast<LeafNode*>(node);
+      LeafNode* leaf = NewLeaf();
+      std::uninitialized_copy(source->values(),
+                              source->values() + source->count_,
+                              leaf->values());
+      leaf->count_ = source->count_;
+      leaf->prev_ = prev;
+      if (prev != nullptr) {
+        prev->next_ = leaf;
+      } else {
+        first_ = leaf;
+      }
+      prev = leaf;
+      return leaf;
+    }
+    InnerNode* source = static_cast<InnerNode*>(node);
+    InnerNode* inner = NewInner();
+    std::uninitialized_copy(source->keys(), source->keys() + source->count_,
+                            inner->keys());
+    for (size_type i = 0; i <= source->count_; ++i) {
+      inner->children_[i] = CopyBranch(source->children_[i], level - 1, prev);
+    }
+    inner->count_ = source->count_;
+    return inner;
+  }
+
+  // count values over width leaves linked from first_ to last_
+  template <class ForwardIt>
+  void BuildLeaves(ForwardIt& first, size_type count, Node** leaves,
+                   size_type width) {
+    try {
+      for (size_type i = 0; i < width; ++i) {
+        LeafNode* leaf = NewLeaf();
+        leaf->prev_ = last_;
+        if (last_ != nullptr) {
+          last_->next_ = leaf;
+        } else {
+          first_ = leaf;
+        }
+        last_ = leaf;
+        leaves[i] = leaf;
+        size_type fill = count / width + (i < count % width ? 1 : 0);
+        for (; leaf->count_ < fill; ++first) {
+          ::new (static_cast<void*>(leaf->values() + leaf->count_))
+              value_type(*first);
+          ++leaf->count_;
+        }
+      }
+    } catch (...) {
+      while (first_ != nullptr) {
+        LeafNode* next = first_->next_;
+        DeleteLeaf(first_);
+        first_ = next;
+      }
+      last_ = nullptr;
+      throw;
+    }
+  }
+
+  /*
+  hangs the width nodes of the current top level under new inner nodes,
+  which replace them at the front of nodes; returns how many were made
+  on failure the whole forest is deleted
+  */
+  size_type BuildInnerLevel(Node** nodes, size_type width) {
+    size_type parents = (width + kInnerCapacity) / (kInnerCapacity + 1);
+    size_type built = 0, next = 0;
+    InnerNode* inner = nullptr;
+    try {
+      for (; built < parents; ++built) {
+        size_type fanout = width / parents + (built < width % parents ? 1 : 0);
+        inner = NewInner();
+        std::copy(nodes + next, nodes + next + fanout, inner->children_);
+        for (; inner->count_ + 1 < fanout; ++inner->count_) {
+          ::new (static_cast<void*>(inner->keys() + inner->count_))
+              key_type(MinKey(inner->children_[inner->count_ + 1], height_));
+        }
+        next += fanout;
+        nodes[built] = inner;
+        inner = nullptr;
+      }
+    } catch (...) {
+      if (inner != nullptr) DeleteInner(inner);
+      for (size_type i = 0; i < built; ++i) DeleteBranch(nodes[i], height_ + 1);
+      for (size_type i = next; i < width; ++i) DeleteBranch(nodes[i], height_);
+      first_ = last_ = nullptr;
+      height_ = 0;
+      throw;
+    }
+    ++height_;
+    return parents;
+  }
+
+  const key_type& MinKey(Node* node, size_type level) const noexcept {
+    for (; level > 0; --level) {
+      node = static_cast<InnerNode*>(node)->children_[0];
+    }
+    return key_of_(static_cast<LeafNode*>(node)->values()[0]);
+  }
+
+  void DeleteBranch(Node* node, size_type level) noexcept {
+    if (level == 0) {
+      DeleteLeaf(static_cast<LeafNode*>(node));
+      return;
+    }
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    for (size_type i = 0; i <= inner->count_; ++i) {
+      DeleteBranch(inner->children_[i], level - 1);
+    }
+    DeleteInner(inner);
+  }
+
+  LeafNode* NewLeaf() {
+    LeafNode* leaf = ::new (static_cast<void*>(
+        leaf_traits::allocate(leaf_allocator_, 1))) LeafNode;
+    leaf->count_ = 0;
+    leaf->prev_ = nullptr;
+    leaf->next_ = nullptr;
+    return leaf;
+  }
+
+  InnerNode* NewInner() {
+    InnerNode* inner = ::new (static_cast<void*>(
+        inner_traits::allocate(inner_allocator_, 1))) InnerNode;
+    inner->count_ = 0;
+    return inner;
+  }
+
+  void DeleteLeaf(LeafNode* leaf) noexcept {
+    EraseValues(leaf->values(), leaf->count_);
+    leaf_traits::deallocate(leaf_allocator_, leaf, 1);
+  }
+
+  void DeleteInner(InnerNode* inner) noexcept {
+    std::destroy(inner->keys(), inner->keys() + inner->count_);
+    inner_traits::deallocate(inner_allocator_, inner, 1);
+  }
+
+  Node* root_;
+  LeafNode* first_;
+  LeafNode* last_;
+  size_type height_;
+  size_type size_;
+  Compare is_less_;
+  KeyOfValue key_of_;
+  [[no_unique_address]] leaf_allocator_type leaf_allocator_;
+  [[no_unique_address]] inner_allocator_type inner_allocator_;
+};
+
+/*
+B+ tree backend for s21::map and s21::Set; unlike the node based
+backends, insert and erase invalidate iterators (see BPlusTree)
+*/
+struct BPlusTreeBackend {
+  template <class Key, class Value, class KeyOfValue, class Compare,
+            class Allocator>
+  using tree_type = BPlusTree<Key, Value, KeyOfValue, Compare, Allocator>;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_BPLUSTREE_H_
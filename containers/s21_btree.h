@@ -1,12 +1,132 @@
 #ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_BTREE_H_
 #define CPP2_S21_CONTAINERS_CONTAINERS_S21_BTREE_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "s21_node_pool.h"
+#include "s21_vector.h"
 
 namespace s21 {
 
-template <class Key, class Comparator = std::less<Key>>
+template <class Compare, class Left, class Right, class = void>
+struct HasThreeWayCompare : std::false_type {};
+
+template <class Compare, class Left, class Right>
+struct HasThreeWayCompare<
+    Compare, Left, Right,
+    std::void_t<decltype(std::declval<const Compare&>().compare(
+        std::declval<const Left&>(), std::declval<const Right&>()))>>
+    : std::true_type {};
+
+template <class T>
+inline constexpr bool kIsStdString =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <class Compare>
+inline constexpr bool kIsStdStringLess =
+    std::is_same_v<Compare, std::less<>> ||
+    std::is_same_v<Compare, std::less<std::string>> ||
+    std::is_same_v<Compare, std::less<std::string_view>>;
+
+/*
+three-way comparison protocol of the trees: negative if left < right,
+zero if they are equivalent, positive otherwise
+a comparator opts in with a member compare(left, right) returning int;
+std::less over std::string keys uses string::compare, everything else
+falls back to two calls of is_less
+*/
+template <class Compare, class Left, class Right>
+int ThreeWayCompare(const Compare& is_less, const Left& left,
+                    const Right& right) {
+  if constexpr (HasThreeWayCompare<Compare, Left, Right>::value) {
+    return is_less.compare(left, right);
+  } else if constexpr (kIsStdStringLess<Compare> &&
+                       (kIsStdString<Left> || kIsStdString<Right>) &&
+                       std::is_convertible_v<const Left&, std::string_view> &&
+                       std::is_convertible_v<const Right&, std::string_view>) {
+    return std::string_view(left).compare(std::string_view(right));
+  } else {
+    return is_less(left, right) ? -1 : (is_less(right, left) ? 1 : 0);
+  }
+}
+
+// pair of iterators usable in a range-based for, e.g. a bounded scan
+template <class Iterator>
+class IteratorRange {
+ public:
+  IteratorRange(Iterator first, Iterator last) : first_(first), last_(last) {}
+
+  Iterator begin() const noexcept { return first_; }
+  Iterator end() const noexcept { return last_; }
+  bool empty() const noexcept { return first_ == last_; }
+
+ private:
+  Iterator first_;
+  Iterator last_;
+};
+
+// marks a range already sorted by the comparator and free of duplicates
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+// subtree size kept in the nodes of order-statistic trees
+template <bool Enabled>
+struct SubtreeSize {
+  std::size_t subtree_size_;
+};
+
+template <>
+struct SubtreeSize<false> {};
+
+// in-order neighbours kept in the nodes of threaded trees
+template <bool Enabled, class Node>
+struct InOrderLinks {
+  Node* prev_;
+  Node* next_;
+};
+
+template <class Node>
+struct InOrderLinks<false, Node> {};
+
+// colour and side of a node unless they are packed into its parent link
+template <bool Enabled>
+struct NodeFlags {
+  bool black_;
+  bool left_child_;
+};
+
+template <>
+struct NodeFlags<false> {};
+
+/*
+nodes (and the nill sentinel) are allocated from Allocator rebound to the
+node type, copies and moves follow the std allocator propagation traits
+with OrderStatistic every node also counts its subtree (the nill counts
+zero), which gives rank(), select() and iterator + n in O(log n)
+with Threaded every node also links its in-order neighbours in a ring
+through the nill, so ++ and -- never climb the tree
+with Compact the colour and the side of a node are kept in the two low
+bits of its parent link (nodes are pointer aligned), so the node is three
+pointers and the key; keys narrower than a pointer are padded to it, so
+Compact saves nothing for them (see CompactTreeBackend)
+*/
+template <class Key, class Comparator = std::less<Key>,
+          class Allocator = std::allocator<Key>, bool OrderStatistic = false,
+          bool Threaded = false, bool Compact = false>
 class RedBlackTree {
  public:
   class RedBlackTreeNode;
@@ -19,45 +139,120 @@ class RedBlackTree {
   using const_reference = const key_type&;
   using iterator = RedBlackTreeIterator;
   using const_iterator = RedBlackTreeConstIterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using node_type = RedBlackTreeNode;
   using size_type = std::size_t;
-  using tree_type = RedBlackTree<key_type, Comparator>;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using tree_type = RedBlackTree<key_type, Comparator, allocator_type,
+                                 OrderStatistic, Threaded, Compact>;
+  using node_allocator_type = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<node_type>;
+  using node_pool_type = NodePool<node_type, node_allocator_type>;
+
+ private:
+  using alloc_traits = std::allocator_traits<allocator_type>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
 
-  RedBlackTree()
-      : head_(nullptr), nill_leaf_(new node_type{}), size_(size_type{}) {
-    nill_leaf_->black_ = true;
+ public:
+  RedBlackTree() : RedBlackTree(Comparator(), allocator_type()) {}
+
+  explicit RedBlackTree(const allocator_type& alloc)
+      : RedBlackTree(Comparator(), alloc) {}
+
+  explicit RedBlackTree(const Comparator& comp,
+                        const allocator_type& alloc = allocator_type())
+      : head_(nullptr),
+        nill_leaf_(nullptr),
+        size_(size_type{}),
+        is_less_(comp),
+        pool_(node_allocator_type(alloc)) {
+    nill_leaf_ = CreateNill();
   }
 
-  RedBlackTree(const tree_type& other) noexcept : RedBlackTree() {
+  RedBlackTree(const tree_type& other)
+      : RedBlackTree(alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())) {
     CopyTree(other);
   }
 
-  RedBlackTree(tree_type&& other) noexcept : RedBlackTree() { swap(other); }
+  RedBlackTree(tree_type&& other) : RedBlackTree(other.get_allocator()) {
+    swap(other);
+  }
 
-  tree_type& operator=(const tree_type& other) noexcept {
+  tree_type& operator=(const tree_type& other) {
     if (this != &other) {
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (get_allocator() != other.get_allocator()) {
+          clear();
+          DestroyNill();
+          pool_ = node_pool_type(node_allocator_type(other.get_allocator()));
+          nill_leaf_ = CreateNill();
+        }
+      }
       CopyTree(other);
     }
     return *this;
   }
 
-  tree_type& operator=(tree_type&& other) noexcept {
+  /*
+  the nodes of other are stolen when its allocator comes along or is equal
+  to ours, otherwise the keys are moved one by one into our own nodes
+  */
+  tree_type& operator=(tree_type&& other) {
+    if (this == &other) return *this;
     clear();
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::
+                      value &&
+                  !alloc_traits::is_always_equal::value) {
+      if (get_allocator() != other.get_allocator()) {
+        reserve(other.size_);
+        is_less_ = other.is_less_;
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+          InsertNode(pool_.Create(std::move(*it)));
+        }
+        other.clear();
+        return *this;
+      }
+    }
     swap(other);
     return *this;
   }
 
   ~RedBlackTree() {
     clear();
-    delete nill_leaf_;
+    DestroyNill();
     head_ = nullptr;
     nill_leaf_ = nullptr;
   }
 
-  void clear() {
-    DeleteBranch(head_);
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(pool_.get_allocator());
+  }
+
+  /*
+  the slabs are kept for the next nodes, so a reservation survives; for
+  trivially destructible keys clearing costs O(1) instead of O(n)
+  */
+  void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<node_type>) {
+      DestroyBranch(head_);
+    }
+    pool_.Reset();
     size_ = 0;
     head_ = nullptr;
+    nill_leaf_->left_ = nullptr;
+    nill_leaf_->right_ = nullptr;
+  }
+
+  /*
+  after reserve(n) the tree can grow up to n nodes without allocating,
+  clear() included; the memory is freed with the tree
+  */
+  void reserve(size_type n) {
+    if (n > size_) pool_.Reserve(n - size_);
   }
 
   bool empty() const noexcept { return size_ == 0; }
@@ -71,70 +266,166 @@ class RedBlackTree {
   }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    node_type* new_node = new node_type{value};
-    return InsertNode(new_node);
+    return EmplaceUnique(value, value);
+  }
+
+  // the value is built first, its node is dropped again if the key exists
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    node_type* new_node =
+        pool_.Create(std::in_place, std::forward<Args>(args)...);
+    std::pair<iterator, bool> result = InsertNode(new_node);
+    if (!result.second) pool_.Destroy(new_node);
+    return result;
+  }
+
+  /*
+  one descent: returns the node equal to key or builds the value from args
+  in a new node hung where the search ended
+  */
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceUnique(const K& key, Args&&... args) {
+    node_type* parent = nullptr;
+    bool left = false;
+    node_type* node = FindSlot(key, parent, left);
+    if (node != nullptr) return {iterator(node), false};
+    node_type* new_node =
+        pool_.Create(std::in_place, std::forward<Args>(args)...);
+    LinkNode(new_node, parent, left);
+    return {iterator(new_node), true};
+  }
+
+  /*
+  EmplaceUnique that first tries the slot right before hint (end() is
+  checked against the cached maximum): if key belongs there, the node is
+  linked without a descent, amortized O(1)
+  */
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceHint(iterator hint, const K& key,
+                                        Args&&... args) {
+    node_type* parent = nullptr;
+    bool left = false;
+    if (!HintSlot(hint.node_, key, parent, left)) {
+      node_type* node = FindSlot(key, parent, left);
+      if (node != nullptr) return {iterator(node), false};
+    }
+    node_type* new_node =
+        pool_.Create(std::in_place, std::forward<Args>(args)...);
+    LinkNode(new_node, parent, left);
+    return {iterator(new_node), true};
   }
 
   std::pair<iterator, bool> InsertNode(node_type* new_node) noexcept {
-    node_type *node = head_, *parent = nullptr;
-    while (node != nullptr && node->parent_ != nullptr) {
+    node_type* parent = nullptr;
+    bool left = false;
+    node_type* node = FindSlot(new_node->key_, parent, left);
+    if (node != nullptr) return {iterator(node), false};
+    LinkNode(new_node, parent, left);
+    return {iterator(new_node), true};
+  }
+
+  /*
+  returns the node equal to key, or nullptr and the leaf (parent and side)
+  under which key belongs
+  */
+  template <class K>
+  node_type* FindSlot(const K& key, node_type*& parent,
+                      bool& left) const noexcept {
+    node_type* node = head_;
+    while (node != nullptr && node->Parent() != nullptr) {
       parent = node;
-      if (is_less_(new_node->key_, node->key_)) {
-        // new_node < node
-        node = node->left_;
-      } else {
-        // new_node >= node
-        if (is_less_(node->key_, new_node->key_)) {
-          // new_node > node
-          node = node->right_;
-        } else {
-          // new_node == node
-          return {iterator(node), false};
-        }
-      }
+      int order = ThreeWayCompare(is_less_, key, node->key_);
+      if (order == 0) return node;
+      left = order < 0;
+      node = left ? node->left_ : node->right_;
     }
+    return nullptr;
+  }
+
+  // leaf slot between the predecessor of hint and hint, if key goes there
+  template <class K>
+  bool HintSlot(node_type* hint, const K& key, node_type*& parent,
+                bool& left) const noexcept {
+    if (head_ == nullptr) return false;
+    if (hint != nill_leaf_ && !is_less_(key, hint->key_)) return false;
+    node_type* prev = hint == nill_leaf_->left_ ? nullptr : hint->PrevNode();
+    if (prev != nullptr && !is_less_(prev->key_, key)) return false;
+    // the predecessor has no right child or hint has no left one
+    left = prev == nullptr || prev->right_ != nill_leaf_;
+    parent = left ? hint : prev;
+    return true;
+  }
 
+  void LinkNode(node_type* new_node, node_type* parent, bool left) noexcept {
     if (parent == nullptr) {
       head_ = new_node;
-      head_->black_ = true;
-      head_->parent_ = nill_leaf_;
+      head_->SetBlack(true);
+      head_->SetParent(nill_leaf_);
+      nill_leaf_->left_ = new_node;
+      nill_leaf_->right_ = new_node;
+      if constexpr (Threaded) {
+        new_node->prev_ = nill_leaf_;
+        new_node->next_ = nill_leaf_;
+        nill_leaf_->prev_ = new_node;
+        nill_leaf_->next_ = new_node;
+      }
     } else {
-      new_node->parent_ = parent;
-      if (is_less_(new_node->key_, parent->key_)) {
-        // new_node < parent
+      if constexpr (OrderStatistic) {
+        for (node_type* node = parent; node->Parent() != nullptr;
+             node = node->Parent()) {
+          ++node->subtree_size_;
+        }
+      }
+      new_node->SetParent(parent);
+      new_node->SetLeftChild(left);
+      if constexpr (Threaded) {
+        // the list is a ring through the nill, whose next_ is the minimum
+        new_node->prev_ = left ? parent->prev_ : parent;
+        new_node->next_ = left ? parent : parent->next_;
+        new_node->prev_->next_ = new_node;
+        new_node->next_->prev_ = new_node;
+      }
+      if (left) {
         parent->left_ = new_node;
-        new_node->left_child_ = true;
+        // only a left child of the minimum becomes the new minimum
+        if (parent == nill_leaf_->left_) nill_leaf_->left_ = new_node;
       } else {
-        // new_node > parent
         parent->right_ = new_node;
-        new_node->left_child_ = false;
+        if (parent == nill_leaf_->right_) nill_leaf_->right_ = new_node;
       }
     }
     ++size_;
     new_node->left_ = nill_leaf_;
     new_node->right_ = nill_leaf_;
 
-    if (nill_leaf_->right_ == nullptr) {
-      nill_leaf_->right_ = new_node;
-    } else {
-      if (is_less_(nill_leaf_->right_->key_, new_node->key_))
-        nill_leaf_->right_ = new_node;
-    }
-    if (nill_leaf_->left_ == nullptr) {
-      nill_leaf_->left_ = new_node;
-    } else {
-      if (is_less_(new_node->key_, nill_leaf_->left_->key_))
-        nill_leaf_->left_ = new_node;
-    }
-
     CheckColor(new_node);
-    return {iterator(new_node), true};
   }
 
-  iterator begin() noexcept { return iterator(MostLeft(head_)); }
+  // the minimum and the maximum are cached in the nill, both ends are O(1)
+  iterator begin() noexcept {
+    return iterator(head_ == nullptr ? nill_leaf_ : nill_leaf_->left_);
+  }
 
   iterator end() noexcept { return iterator(nill_leaf_); }
 
+  const_iterator begin() const noexcept {
+    return const_iterator(const_cast<tree_type*>(this)->begin());
+  }
+
+  const_iterator end() const noexcept { return const_iterator(nill_leaf_); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
   node_type* MostLeft(node_type* pos) noexcept {
     if (pos == nullptr) return nill_leaf_;
     node_type* min = pos;
@@ -155,29 +446,62 @@ class RedBlackTree {
 
   /*
   return iterator on nill if not found
-  else returns iterator on desired node
+  else returns iterator on desired node;
+  key may be a stored value or anything Comparator orders against one
   */
-  iterator find(const_reference key) const noexcept {
+  template <class K>
+  iterator find(const K& key) const noexcept {
     if (head_ == nullptr) return iterator{nill_leaf_};
     node_type* cur = head_;
-    while (cur) {
-      if (cur == nill_leaf_) {
-        break;
+    while (cur != nill_leaf_) {
+      int order = ThreeWayCompare(is_less_, key, cur->key_);
+      if (order == 0) break;
+      cur = order < 0 ? cur->left_ : cur->right_;
+    }
+    return iterator(cur);
+  }
+
+  // first node not less than key, end() if there is none
+  template <class K>
+  iterator lower_bound(const K& key) const noexcept {
+    node_type* bound = nill_leaf_;
+    for (node_type* cur = head_ == nullptr ? nill_leaf_ : head_;
+         cur != nill_leaf_;) {
+      if (is_less_(cur->key_, key)) {
+        cur = cur->right_;
+      } else {
+        bound = cur;
+        cur = cur->left_;
       }
+    }
+    return iterator(bound);
+  }
+
+  // first node greater than key, end() if there is none
+  template <class K>
+  iterator upper_bound(const K& key) const noexcept {
+    node_type* bound = nill_leaf_;
+    for (node_type* cur = head_ == nullptr ? nill_leaf_ : head_;
+         cur != nill_leaf_;) {
       if (is_less_(key, cur->key_)) {
-        // cur > key
+        bound = cur;
         cur = cur->left_;
       } else {
-        // cur <= key
-        if (is_less_(cur->key_, key)) {
-          cur = cur->right_;
-          // cur < key
-        } else {
-          break;
-        }
+        cur = cur->right_;
       }
     }
-    return iterator(cur);
+    return iterator(bound);
+  }
+
+  // keys are unique, so the range holds at most the node equal to key
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K& key) const noexcept {
+    iterator first = lower_bound(key);
+    iterator last = first;
+    if (first.node_ != nill_leaf_ && !is_less_(key, first.node_->key_)) {
+      ++last;
+    }
+    return {first, last};
   }
 
   void swap(tree_type& other) noexcept {
@@ -185,10 +509,20 @@ class RedBlackTree {
     std::swap(other.size_, size_);
     std::swap(other.is_less_, is_less_);
     std::swap(other.nill_leaf_, nill_leaf_);
+    pool_.swap(other.pool_);
   }
 
-  void merge(tree_type& other) noexcept {
-    if (this != &other) {
+  /*
+  moves every key missing here out of other, duplicates stay in other
+  with equal allocators and a stateless comparator the pool of other is
+  taken over and both trees are united by split and join in
+  O(m log(n / m + 1)) work, forking across threads while the parts are
+  large; the duplicates are then moved back into new nodes of other
+  otherwise the keys are moved into new nodes one by one
+  */
+  void merge(tree_type& other) {
+    if (this == &other || other.head_ == nullptr) return;
+    if (!kJoinable || get_allocator() != other.get_allocator()) {
       iterator other_it = other.begin();
       iterator other_end = other.end();
       iterator tmp = other_it;
@@ -198,43 +532,151 @@ class RedBlackTree {
           tmp = other_it;
           ++tmp;
           moving_node = other.ExtractNode(other_it.node_);
-          InsertNode(moving_node);
+          InsertNode(pool_.Create(std::move(moving_node->key_)));
+          other.pool_.Destroy(moving_node);
           other_it = tmp;
         } else {
           ++other_it;
         }
       }
+      return;
+    }
+
+    pool_.Splice(other.pool_);
+    Branch theirs{other.head_, BlackHeight(other.head_)};
+    Relink(theirs, other.nill_leaf_, ForkBudget());
+    size_type theirs_size = other.size_;
+    other.head_ = nullptr;
+    other.size_ = 0;
+    other.nill_leaf_->left_ = nullptr;
+    other.nill_leaf_->right_ = nullptr;
+
+    Chain duplicates{};
+    AdoptRoot(Union(Whole(), theirs, duplicates, ForkBudget()).root_);
+    size_ += theirs_size - duplicates.size_;
+    node_type* node = duplicates.head_;
+    try {
+      for (; node != nullptr; node = duplicates.head_) {
+        duplicates.head_ = node->right_;
+        other.EmplaceHint(other.end(), node->key_, std::move(node->key_));
+        pool_.Destroy(node);
+      }
+    } catch (...) {
+      pool_.Destroy(node);
+      DestroyChain(duplicates);
+      throw;
     }
   }
 
-  bool contains(const_reference key) const noexcept {
+  // adds copies of the keys of other missing here
+  void unite(const tree_type& other) {
+    if (this == &other || other.head_ == nullptr) return;
+    tree_type copy(get_allocator());
+    copy.CopyTree(other);
+    merge(copy);
+  }
+
+  // keeps only the keys other contains as well
+  void intersect(const tree_type& other) noexcept {
+    if (this == &other || head_ == nullptr) return;
+    if (other.head_ == nullptr) {
+      clear();
+      return;
+    }
+    if constexpr (kJoinable) {
+      Chain dropped{};
+      AdoptRoot(Intersect(Whole(), other.head_, dropped, ForkBudget()).root_);
+      size_ -= dropped.size_;
+      DestroyChain(dropped);
+    } else {
+      for (iterator it = begin(); it != end();) {
+        iterator next = it;
+        ++next;
+        if (!other.contains(*it)) erase(it);
+        it = next;
+      }
+    }
+  }
+
+  // removes the keys other contains
+  void subtract(const tree_type& other) noexcept {
+    if (head_ == nullptr || other.head_ == nullptr) return;
+    if (this == &other) {
+      clear();
+      return;
+    }
+    if constexpr (kJoinable) {
+      Chain dropped{};
+      AdoptRoot(Subtract(Whole(), other.head_, dropped, ForkBudget()).root_);
+      size_ -= dropped.size_;
+      DestroyChain(dropped);
+    } else {
+      for (iterator it = begin(); it != end();) {
+        iterator next = it;
+        ++next;
+        if (other.contains(*it)) erase(it);
+        it = next;
+      }
+    }
+  }
+
+  template <class K>
+  bool contains(const K& key) const noexcept {
     return ((find(key).node_) != nill_leaf_);
   }
 
+  // number of keys less than key
+  template <class K>
+  size_type rank(const K& key) const noexcept {
+    static_assert(OrderStatistic, "rank() needs an order-statistic tree");
+    size_type less = 0;
+    node_type* cur = head_ == nullptr ? nill_leaf_ : head_;
+    while (cur != nill_leaf_) {
+      int order = ThreeWayCompare(is_less_, key, cur->key_);
+      if (order > 0) less += cur->left_->subtree_size_ + 1;
+      if (order == 0) return less + cur->left_->subtree_size_;
+      cur = order < 0 ? cur->left_ : cur->right_;
+    }
+    return less;
+  }
+
+  // iterator on the k-th smallest key (from zero), end() if k >= size()
+  iterator select(size_type k) const noexcept {
+    static_assert(OrderStatistic, "select() needs an order-statistic tree");
+    if (head_ == nullptr) return iterator(nill_leaf_);
+    return iterator(Select(head_, k));
+  }
+
   void CopyTree(const tree_type& o) {
     clear();
+    reserve(o.size_);
     size_ = o.size_;
     is_less_ = o.is_less_;
     RecursiveCopy(o.head_, nill_leaf_);
+    if (head_ != nullptr) {
+      nill_leaf_->left_ = MostLeft(head_);
+      nill_leaf_->right_ = MostRight(head_);
+      Rethread();
+    }
   }
 
   node_type* RecursiveCopy(node_type* node, node_type* parent) {
     if (node == nullptr) return nullptr;
 
-    node_type* new_node = new node_type{node};
-    new_node->parent_ = parent;
+    node_type* new_node = pool_.Create(node);
+    new_node->SetParent(parent);
 
-    if (node->parent_->parent_ == nullptr) {
+    if (node->Parent()->Parent() == nullptr) {
       head_ = new_node;
     }
 
-    if (node->left_->parent_ != nullptr) {
+    if (node->left_->Parent() != nullptr) {
       new_node->left_ = RecursiveCopy(node->left_, new_node);
     } else {
       new_node->left_ = nill_leaf_;
     }
 
-    if (node->right_->parent_ != nullptr) {
+    if (node->right_->Parent() != nullptr) {
       new_node->right_ = RecursiveCopy(node->right_, new_node);
     } else {
       new_node->right_ = nill_leaf_;
@@ -242,256 +684,673 @@ class RedBlackTree {
     return new_node;
   }
 
-  void erase(iterator pos) noexcept {
-    node_type* extracted_node = ExtractNode(pos.node_);
-    delete extracted_node;
+  /*
+  replaces the contents with [first, last), which must be sorted and free
+  of duplicates, in O(n): the nodes are made in order from one reservation
+  and hung as a perfectly balanced tree whose deepest level is red
+  */
+  template <class ForwardIt>
+  void BuildSorted(ForwardIt first, ForwardIt last) {
+    clear();
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    if (count == 0) return;
+    reserve(count);
+    size_type height = 0;
+    for (size_type n = count; n != 0; n /= 2) ++height;
+    try {
+      head_ = BuildBranch(first, count, 0, height - 1);
+    } catch (...) {
+      pool_.Release();
+      throw;
+    }
+    head_->SetParent(nill_leaf_);
+    head_->SetBlack(true);
+    size_ = count;
+    nill_leaf_->left_ = MostLeft(head_);
+    nill_leaf_->right_ = MostRight(head_);
+    Rethread();
+  }
+
+  /*
+  links the nodes of a threaded tree in order after it was built or
+  rearranged wholesale, O(n)
+  */
+  void Rethread() noexcept {
+    if constexpr (Threaded) {
+      node_type* prev = nill_leaf_;
+      ThreadBranch(head_, prev);
+      prev->next_ = nill_leaf_;
+      nill_leaf_->prev_ = prev;
+    }
+  }
+
+  void ThreadBranch(node_type* node, node_type*& prev) noexcept {
+    if (node == nullptr || node == nill_leaf_) return;
+    ThreadBranch(node->left_, prev);
+    node->prev_ = prev;
+    prev->next_ = node;
+    prev = node;
+    ThreadBranch(node->right_, prev);
+  }
+
+  // subtree of the next count values; a failed branch destroys its keys
+  template <class ForwardIt>
+  node_type* BuildBranch(ForwardIt& first, size_type count, size_type depth,
+                         size_type red_depth) {
+    if (count == 0) return nill_leaf_;
+    node_type* left = BuildBranch(first, count / 2, depth + 1, red_depth);
+    node_type* node = nullptr;
+    try {
+      node = pool_.Create(std::in_place, *first);
+      ++first;
+    } catch (...) {
+      DestroyBranch(left);
+      if (node != nullptr) node->~node_type();
+      throw;
+    }
+    node->left_ = left;
+    try {
+      node->right_ =
+          BuildBranch(first, count - count / 2 - 1, depth + 1, red_depth);
+    } catch (...) {
+      DestroyBranch(node);
+      throw;
+    }
+    if (left != nill_leaf_) {
+      left->SetParent(node);
+      left->SetLeftChild(true);
+    }
+    if (node->right_ != nill_leaf_) node->right_->SetParent(node);
+    node->SetBlack(depth == 0 || depth != red_depth);
+    if constexpr (OrderStatistic) node->subtree_size_ = count;
+    return node;
+  }
+
+  // comparator of the tree, it also orders bare keys
+  const Comparator& key_comp() const noexcept { return is_less_; }
+
+  void erase(iterator pos) noexcept { pool_.Destroy(ExtractNode(pos.node_)); }
+
+  // moves the value at pos out of the tree as T, its node goes back to pool_
+  template <class T>
+  T Extract(iterator pos) {
+    T value(MoveOutOfSlot(pos.node_->key_));
+    pool_.Destroy(ExtractNode(pos.node_));
+    return value;
   }
 
-  // инструкция, по которой написан код:
-  // https://habr.com/ru/companies/otus/articles/521034/
   node_type* ExtractNode(node_type* pos) noexcept {
+    if (pos == nill_leaf_) {
+      return nullptr;
+    }
     if (pos == nill_leaf_->left_) {
-      nill_leaf_->left_ = pos->parent_;
+      nill_leaf_->left_ = pos->NextNode();
     }
     if (pos == nill_leaf_->right_) {
-      nill_leaf_->right_ = pos->parent_;
+      nill_leaf_->right_ = pos->PrevNode();
     }
-    if (pos == nill_leaf_) {
-      return nullptr;
+    if constexpr (Threaded) {
+      pos->prev_->next_ = pos->next_;
+      pos->next_->prev_ = pos->prev_;
     }
-    node_type* exchanging_node = nullptr;
 
-    // красный или черный члены с двумя детьми
+    // красный или черный член с двумя детьми меняется местами со следующим
     if (pos->left_ != nill_leaf_ && pos->right_ != nill_leaf_) {
-      exchanging_node = MostLeft(pos->right_);
-      if (exchanging_node->left_->parent_ != nullptr ||
-          exchanging_node->right_->parent_ != nullptr) {
-        exchanging_node = MostRight(pos->left_);
-      }
-      SwapNodesValues(pos, exchanging_node);
+      SwapNodesValues(pos, MostLeft(pos->right_));
     }
 
-    // черный член с одним ребенком
-    if (pos->black_ == true &&
-        (pos->left_ == nill_leaf_) ^ (pos->right_ == nill_leaf_)) {
-      exchanging_node = (pos->right_ == nill_leaf_ ? pos->left_ : pos->right_);
-      SwapNodesValues(pos, exchanging_node);
-    }
-
-    // черный бездетный член
-    if (pos->black_ == true && pos->left_ == nill_leaf_ &&
-        pos->right_ == nill_leaf_) {
+    // черный член с одним ребенком: ребенок всегда красный лист
+    node_type* child = (pos->left_ != nill_leaf_ ? pos->left_ : pos->right_);
+    if (child != nill_leaf_) {
+      SwapNodesValues(pos, child);
+    } else if (pos->IsBlack()) {
+      // черный бездетный член
       BalanceBlackChildFreeNode(pos);
     }
 
     // выдергивание члена
     if (pos != head_) {
-      if (pos->left_child_) {
-        pos->parent_->left_ = nill_leaf_;
+      if (pos->IsLeftChild()) {
+        pos->Parent()->left_ = nill_leaf_;
       } else {
-        pos->parent_->right_ = nill_leaf_;
+        pos->Parent()->right_ = nill_leaf_;
       }
     } else {
       head_ = nullptr;
     }
+    if constexpr (OrderStatistic) {
+      for (node_type* node = pos->Parent(); node->Parent() != nullptr;
+           node = node->Parent()) {
+        --node->subtree_size_;
+      }
+    }
     --size_;
+    if (size_ == 0) {
+      nill_leaf_->left_ = nullptr;
+      nill_leaf_->right_ = nullptr;
+    }
     pos->MakeDefault();
     return pos;
   }
 
+  /*
+  узел остается в дереве листом с "двойной черной" окраской,
+  пока черная высота не будет восстановлена
+  */
   void BalanceBlackChildFreeNode(node_type* node) noexcept {
-    if (node == head_) {
+    while (node != head_ && node->IsBlack()) {
+      node_type* parent = node->Parent();
+      if (node->IsLeftChild()) {
+        node_type* sibling = parent->right_;
+        // брат красный
+        if (!sibling->IsBlack()) {
+          sibling->SetBlack(true);
+          parent->SetBlack(false);
+          LeftRotation(parent);
+          sibling = parent->right_;
+        }
+        if (sibling->left_->IsBlack() && sibling->right_->IsBlack()) {
+          // брат черный с черными детьми
+          sibling->SetBlack(false);
+          node = parent;
+        } else {
+          // дальний племянник черный, ближний красный
+          if (sibling->right_->IsBlack()) {
+            sibling->left_->SetBlack(true);
+            sibling->SetBlack(false);
+            RightRotation(sibling);
+            sibling = parent->right_;
+          }
+          // дальний племянник красный
+          sibling->SetBlack(parent->IsBlack());
+          parent->SetBlack(true);
+          sibling->right_->SetBlack(true);
+          LeftRotation(parent);
+          node = head_;
+        }
+      } else {
+        // зеркальный случай
+        node_type* sibling = parent->left_;
+        if (!sibling->IsBlack()) {
+          sibling->SetBlack(true);
+          parent->SetBlack(false);
+          RightRotation(parent);
+          sibling = parent->left_;
+        }
+        if (sibling->left_->IsBlack() && sibling->right_->IsBlack()) {
+          sibling->SetBlack(false);
+          node = parent;
+        } else {
+          if (sibling->left_->IsBlack()) {
+            sibling->right_->SetBlack(true);
+            sibling->SetBlack(false);
+            LeftRotation(sibling);
+            sibling = parent->left_;
+          }
+          sibling->SetBlack(parent->IsBlack());
+          parent->SetBlack(true);
+          sibling->left_->SetBlack(true);
+          RightRotation(parent);
+          node = head_;
+        }
+      }
+    }
+    node->SetBlack(true);
+  }
+
+  // меняет местами положения двух узлов в дереве, включая соседние узлы
+  void SwapNodesValues(node_type* current,
+                       node_type* exchanging_node) noexcept {
+    node_type *cur_parent = current->Parent(), *cur_left = current->left_,
+              *cur_right = current->right_;
+    node_type *exc_parent = exchanging_node->Parent(),
+              *exc_left = exchanging_node->left_,
+              *exc_right = exchanging_node->right_;
+    bool cur_left_child = current->IsLeftChild(),
+         exc_left_child = exchanging_node->IsLeftChild();
+
+    if (exc_parent == current) exc_parent = exchanging_node;
+    if (cur_parent == exchanging_node) cur_parent = current;
+    if (cur_left == exchanging_node) cur_left = current;
+    if (cur_right == exchanging_node) cur_right = current;
+    if (exc_left == current) exc_left = exchanging_node;
+    if (exc_right == current) exc_right = exchanging_node;
+
+    exchanging_node->SetParent(cur_parent);
+    exchanging_node->left_ = cur_left;
+    exchanging_node->right_ = cur_right;
+    exchanging_node->SetLeftChild(cur_left_child);
+    current->SetParent(exc_parent);
+    current->left_ = exc_left;
+    current->right_ = exc_right;
+    current->SetLeftChild(exc_left_child);
+    bool current_black = current->IsBlack();
+    current->SetBlack(exchanging_node->IsBlack());
+    exchanging_node->SetBlack(current_black);
+    if constexpr (OrderStatistic) {
+      std::swap(current->subtree_size_, exchanging_node->subtree_size_);
+    }
+
+    LinkToParent(exchanging_node);
+    LinkToParent(current);
+    LinkChildren(exchanging_node);
+    LinkChildren(current);
+  }
+
+  // SPLIT AND JOIN
+  /*
+  split and join work on subtrees cut out of the tree; every function
+  touches only the nodes of its own subtrees, so independent calls may
+  run on different threads; parent links and subtree sizes are fixed up
+  whenever a node gets new children
+  */
+
+  // comparisons through other must agree with ours
+  static constexpr bool kJoinable = std::is_empty_v<Comparator>;
+
+  // subtrees at least this black-high (2^h - 1 nodes) are worth a thread
+  static constexpr size_type kForkBlackHeight = 10;
+
+  /*
+  a detached subtree and its black height: the number of black nodes on
+  every path from the root down, the root included
+  */
+  struct Branch {
+    node_type* root_;
+    size_type black_height_;
+  };
+
+  struct SplitResult {
+    Branch left_;
+    node_type* middle_;
+    Branch right_;
+  };
+
+  // nodes dropped by the set algebra, in key order, linked through right_
+  struct Chain {
+    node_type* head_;
+    node_type* tail_;
+    size_type size_;
+  };
+
+  Branch Whole() const noexcept {
+    node_type* root = head_ == nullptr ? nill_leaf_ : head_;
+    return {root, BlackHeight(root)};
+  }
+
+  // works for the nodes of any tree, the nill being the node without parent
+  static size_type BlackHeight(const node_type* node) noexcept {
+    size_type height = 0;
+    for (; node->Parent() != nullptr; node = node->left_) {
+      height += node->IsBlack();
+    }
+    return height;
+  }
+
+  void AdoptRoot(node_type* root) noexcept {
+    if (root == nill_leaf_) {
+      head_ = nullptr;
+      nill_leaf_->left_ = nullptr;
+      nill_leaf_->right_ = nullptr;
       return;
     }
+    head_ = root;
+    head_->SetParent(nill_leaf_);
+    head_->SetBlack(true);
+    nill_leaf_->left_ = MostLeft(head_);
+    nill_leaf_->right_ = MostRight(head_);
+    Rethread();
+  }
 
-    node_type *parent = node->parent_,
-              *sibling = node->left_child_ ? parent->right_ : parent->left_;
+  // hangs left and right under node
+  node_type* Attach(node_type* left, node_type* node,
+                    node_type* right) const noexcept {
+    node->left_ = left;
+    node->right_ = right;
+    if (left != nill_leaf_) {
+      left->SetParent(node);
+      left->SetLeftChild(true);
+    }
+    if (right != nill_leaf_) {
+      right->SetParent(node);
+      right->SetLeftChild(false);
+    }
+    if constexpr (OrderStatistic) {
+      node->subtree_size_ =
+          left->subtree_size_ + right->subtree_size_ + 1;
+    }
+    return node;
+  }
 
-    // родитель красный, другой ребёнок чёрный с чёрными внуками
-    if (parent->black_ == false && sibling != nill_leaf_ &&
-        sibling->left_->black_ == true && sibling->right_->black_ == true) {
-      sibling->black_ = false;
-      parent->black_ = true;
+  static void MakeRootBlack(Branch& branch) noexcept {
+    if (!branch.root_->IsBlack()) {
+      branch.root_->SetBlack(true);
+      ++branch.black_height_;
     }
+  }
 
-    // родитель красный, левый ребёнок чёрный с левым красным внуком.
-    if (parent->black_ == false && sibling->black_) {
-      if (sibling->left_child_ == true && sibling->left_->black_ == false) {
-        // брат слева
-        RightRotation(parent);
-        parent->black_ = true;
-        sibling->black_ = false;
+  /*
+  tree of left, key and right, every key of left being less than key and
+  every key of right greater; O(difference of the black heights)
+  */
+  Branch Join(Branch left, node_type* key, Branch right) const noexcept {
+    MakeRootBlack(left);
+    MakeRootBlack(right);
+    if (left.black_height_ > right.black_height_) {
+      node_type* root = JoinRight(left.root_, left.black_height_, key,
+                                  right.root_, right.black_height_);
+      if (!root->IsBlack() && !root->right_->IsBlack()) {
+        root->SetBlack(true);
+        return {root, left.black_height_ + 1};
       }
-      if (sibling->left_child_ == false && sibling->right_->black_ == false) {
-        // брат справа
-        LeftRotation(parent);
-        parent->black_ = true;
-        sibling->black_ = false;
+      return {root, left.black_height_};
+    }
+    if (left.black_height_ < right.black_height_) {
+      node_type* root = JoinLeft(left.root_, left.black_height_, key,
+                                 right.root_, right.black_height_);
+      if (!root->IsBlack() && !root->left_->IsBlack()) {
+        root->SetBlack(true);
+        return {root, right.black_height_ + 1};
       }
+      return {root, right.black_height_};
     }
+    key->SetBlack(false);
+    return {Attach(left.root_, key, right.root_), left.black_height_};
+  }
 
-    // родитель чёрный, левый сын красный, у правого внука чёрные правнуки
-    if (parent->black_ == true && sibling->black_ == false &&
-        sibling->left_->black_ == true && sibling->right_->black_ == true) {
-      if (sibling->left_child_) {
-        if (sibling->right_ != nill_leaf_ && sibling->right_->right_->black_ &&
-            sibling->right_->left_->black_) {
-          sibling->black_ = true;
-          sibling->right_->black_ = false;
-          RightRotation(parent);
-        }
-      } else {
-        if (sibling->left_ != nill_leaf_ && sibling->left_->right_->black_ &&
-            sibling->left_->left_->black_) {
-          sibling->black_ = true;
-          sibling->left_->black_ = false;
-          LeftRotation(parent);
-        }
-      }
+  // key goes down the right spine of the higher left tree
+  node_type* JoinRight(node_type* left, size_type left_height, node_type* key,
+                       node_type* right,
+                       size_type right_height) const noexcept {
+    if (left->IsBlack() && left_height == right_height) {
+      key->SetBlack(false);
+      return Attach(left, key, right);
     }
+    node_type* child = JoinRight(left->right_, left_height - left->IsBlack(),
+                                 key, right, right_height);
+    Attach(left->left_, left, child);
+    if (left->IsBlack() && !child->IsBlack() && !child->right_->IsBlack()) {
+      child->right_->SetBlack(true);
+      return RotateLeftDetached(left);
+    }
+    return left;
+  }
 
-    // родитель чёрный, левый сын красный, у правого внука левый правнук красный
-    if (parent->black_ == true && sibling->black_ == false) {
-      if (sibling->left_child_) {
-        if (sibling->right_ != nill_leaf_ &&
-            sibling->right_->left_->black_ == false) {
-          sibling->right_->left_->black_ = true;
-          LeftRotation(sibling);
-          RightRotation(parent);
-        }
-      } else {
-        if (sibling->left_ != nill_leaf_ &&
-            sibling->left_->right_->black_ == false) {
-          sibling->left_->right_->black_ = true;
-          LeftRotation(sibling);
-          RightRotation(parent);
-        }
-      }
+  node_type* JoinLeft(node_type* left, size_type left_height, node_type* key,
+                      node_type* right,
+                      size_type right_height) const noexcept {
+    if (right->IsBlack() && left_height == right_height) {
+      key->SetBlack(false);
+      return Attach(left, key, right);
+    }
+    node_type* child = JoinLeft(left, left_height, key, right->left_,
+                                right_height - right->IsBlack());
+    Attach(child, right, right->right_);
+    if (right->IsBlack() && !child->IsBlack() && !child->left_->IsBlack()) {
+      child->left_->SetBlack(true);
+      return RotateRightDetached(right);
     }
+    return right;
+  }
 
-    // родитель чёрный, левый сын чёрный с правым красным внуком.
-    if (parent->black_ == true && sibling->black_ == true &&
-        sibling != nill_leaf_) {
-      if (sibling->left_child_) {
-        if (sibling->left_->black_ == false &&
-            sibling->right_->black_ != false) {
-          std::swap(sibling->black_, sibling->left_->black_);
-          RightRotation(sibling);
-          sibling = parent->left_;
-        }
-        if (sibling->right_->black_ == false) {
-          sibling->right_->black_ = true;
-          LeftRotation(sibling);
-          RightRotation(parent);
-          sibling = nill_leaf_;
-        }
-      } else {
-        if (sibling->right_->black_ == false &&
-            sibling->left_->black_ != false) {
-          std::swap(sibling->black_, sibling->right_->black_);
-          LeftRotation(sibling);
-          sibling = parent->right_;
-        }
+  node_type* RotateLeftDetached(node_type* node) const noexcept {
+    node_type* pivot = node->right_;
+    Attach(node->left_, node, pivot->left_);
+    return Attach(node, pivot, pivot->right_);
+  }
 
-        if (sibling->left_->black_ == false) {
-          sibling->left_->black_ = true;
-          RightRotation(sibling);
-          LeftRotation(parent);
-          sibling = nill_leaf_;
-        }
+  node_type* RotateRightDetached(node_type* node) const noexcept {
+    node_type* pivot = node->left_;
+    Attach(pivot->right_, node, node->right_);
+    return Attach(pivot->left_, pivot, node);
+  }
+
+  // join without a middle key: the last node of left takes its place
+  Branch Join2(Branch left, Branch right) const noexcept {
+    if (left.root_ == nill_leaf_) return right;
+    if (right.root_ == nill_leaf_) return left;
+    std::pair<Branch, node_type*> rest = SplitLast(left);
+    return Join(rest.first, rest.second, right);
+  }
+
+  std::pair<Branch, node_type*> SplitLast(Branch branch) const noexcept {
+    node_type* root = branch.root_;
+    Branch left{root->left_, branch.black_height_ - root->IsBlack()};
+    if (root->right_ == nill_leaf_) return {left, root};
+    std::pair<Branch, node_type*> rest =
+        SplitLast({root->right_, branch.black_height_ - root->IsBlack()});
+    return {Join(left, root, rest.first), rest.second};
+  }
+
+  // keys less than key, the node equal to it (or nullptr), keys greater
+  template <class K>
+  SplitResult Split(Branch branch, const K& key) const noexcept {
+    node_type* root = branch.root_;
+    if (root == nill_leaf_) return {branch, nullptr, branch};
+    size_type height = branch.black_height_ - root->IsBlack();
+    Branch left{root->left_, height};
+    Branch right{root->right_, height};
+    int order = ThreeWayCompare(is_less_, key, root->key_);
+    if (order == 0) return {left, root, right};
+    if (order < 0) {
+      SplitResult part = Split(left, key);
+      part.right_ = Join(part.right_, root, right);
+      return part;
+    }
+    SplitResult part = Split(right, key);
+    part.left_ = Join(left, root, part.left_);
+    return part;
+  }
+
+  /*
+  union of two subtrees of this tree, theirs is split around our keys;
+  where both hold a key ours is kept and theirs goes to duplicates
+  */
+  Branch Union(Branch ours, Branch theirs, Chain& duplicates,
+               int forks) const noexcept {
+    if (theirs.root_ == nill_leaf_) return ours;
+    if (ours.root_ == nill_leaf_) return theirs;
+    node_type* pivot = theirs.root_;
+    size_type height = theirs.black_height_ - pivot->IsBlack();
+    Branch theirs_left{pivot->left_, height};
+    Branch theirs_right{pivot->right_, height};
+    SplitResult part = Split(ours, pivot->key_);
+    Chain right_duplicates{};
+    std::pair<Branch, Branch> sides = Fork(
+        forks, std::min(ours.black_height_, theirs.black_height_),
+        [&] { return Union(part.left_, theirs_left, duplicates, forks - 1); },
+        [&] {
+          return Union(part.right_, theirs_right, right_duplicates,
+                       forks - 1);
+        });
+    if (part.middle_ != nullptr) {
+      Push(duplicates, pivot);
+      pivot = part.middle_;
+    }
+    Append(duplicates, right_duplicates);
+    return Join(sides.first, pivot, sides.second);
+  }
+
+  // theirs is only read, nodes are recognized as nill by a null parent
+  Branch Intersect(Branch ours, const node_type* theirs, Chain& dropped,
+                   int forks) const noexcept {
+    if (ours.root_ == nill_leaf_) return ours;
+    if (theirs->Parent() == nullptr) {
+      Collect(ours.root_, dropped);
+      return {nill_leaf_, 0};
+    }
+    SplitResult part = Split(ours, theirs->key_);
+    Chain right_dropped{};
+    std::pair<Branch, Branch> sides = Fork(
+        forks, ours.black_height_,
+        [&] {
+          return Intersect(part.left_, theirs->left_, dropped, forks - 1);
+        },
+        [&] {
+          return Intersect(part.right_, theirs->right_, right_dropped,
+                           forks - 1);
+        });
+    Append(dropped, right_dropped);
+    if (part.middle_ == nullptr) return Join2(sides.first, sides.second);
+    return Join(sides.first, part.middle_, sides.second);
+  }
+
+  Branch Subtract(Branch ours, const node_type* theirs, Chain& dropped,
+                  int forks) const noexcept {
+    if (ours.root_ == nill_leaf_ || theirs->Parent() == nullptr) return ours;
+    SplitResult part = Split(ours, theirs->key_);
+    Chain right_dropped{};
+    std::pair<Branch, Branch> sides = Fork(
+        forks, ours.black_height_,
+        [&] { return Subtract(part.left_, theirs->left_, dropped, forks - 1); },
+        [&] {
+          return Subtract(part.right_, theirs->right_, right_dropped,
+                          forks - 1);
+        });
+    if (part.middle_ != nullptr) Push(dropped, part.middle_);
+    Append(dropped, right_dropped);
+    return Join2(sides.first, sides.second);
+  }
+
+  // points the leaves of a subtree of other at our nill
+  size_type Relink(Branch branch, const node_type* other_nill,
+                   int forks) noexcept {
+    node_type* root = branch.root_;
+    if (root == other_nill) return 0;
+    size_type height = branch.black_height_ - root->IsBlack();
+    std::pair<size_type, size_type> sides = Fork(
+        forks, branch.black_height_,
+        [&] { return Relink({root->left_, height}, other_nill, forks - 1); },
+        [&] { return Relink({root->right_, height}, other_nill, forks - 1); });
+    if (root->left_ == other_nill) root->left_ = nill_leaf_;
+    if (root->right_ == other_nill) root->right_ = nill_leaf_;
+    return sides.first + sides.second + 1;
+  }
+
+  /*
+  runs both tasks, the second one on a new thread while forks are left and
+  the work is large; without a thread both simply run here
+  */
+  template <class Left, class Right>
+  static auto Fork(int forks, size_type black_height, Left&& left,
+                   Right&& right) noexcept
+      -> std::pair<decltype(left()), decltype(right())> {
+    if (forks > 0 && black_height >= kForkBlackHeight) {
+      std::future<decltype(right())> other;
+      try {
+        other = std::async(std::launch::async, right);
+      } catch (...) {
+        return {left(), right()};
       }
+      auto first = left();
+      return {first, other.get()};
     }
+    auto first = left();
+    return {first, right()};
+  }
 
-    // родитель чёрный, левый сын чёрный, его внуки тоже чёрные
-    if (parent->black_ == true && sibling != nill_leaf_ &&
-        sibling->black_ == true && sibling->left_->black_ == true &&
-        sibling->right_->black_ == true) {
-      sibling->black_ = false;
-      // В результате чёрная высота всей нашей структуры уменьшится на 1 и мы
-      // должны рекурсивно воззвать балансировку к праотцам.
-      BalanceBlackChildFreeNode(parent);
+  // threads for about twice the cores at the top of the recursion
+  static int ForkBudget() noexcept {
+    int forks = 1;
+    for (unsigned cores = std::thread::hardware_concurrency(); cores > 1;
+         cores /= 2) {
+      ++forks;
     }
+    return forks;
   }
 
-  void SwapNodesValues(node_type* current,
-                       node_type* exchanging_node) noexcept {
-    if (current == head_) {
-      head_ = exchanging_node;
+  static void Push(Chain& chain, node_type* node) noexcept {
+    node->right_ = nullptr;
+    if (chain.tail_ != nullptr) {
+      chain.tail_->right_ = node;
     } else {
-      if (current->left_child_) {
-        current->parent_->left_ = exchanging_node;
-      } else {
-        current->parent_->right_ = exchanging_node;
-      }
+      chain.head_ = node;
     }
+    chain.tail_ = node;
+    ++chain.size_;
+  }
 
-    if (exchanging_node->left_child_) {
-      exchanging_node->parent_->left_ = current;
+  static void Append(Chain& chain, const Chain& rest) noexcept {
+    if (rest.head_ == nullptr) return;
+    if (chain.tail_ != nullptr) {
+      chain.tail_->right_ = rest.head_;
     } else {
-      exchanging_node->parent_->right_ = current;
+      chain.head_ = rest.head_;
     }
+    chain.tail_ = rest.tail_;
+    chain.size_ += rest.size_;
+  }
 
-    std::swap(current->black_, exchanging_node->black_);
-    std::swap(current->left_, exchanging_node->left_);
-    std::swap(current->right_, exchanging_node->right_);
-    std::swap(current->left_child_, exchanging_node->left_child_);
-    std::swap(current->parent_, exchanging_node->parent_);
+  void Collect(node_type* root, Chain& chain) const noexcept {
+    if (root == nill_leaf_) return;
+    Collect(root->left_, chain);
+    node_type* right = root->right_;
+    Push(chain, root);
+    Collect(right, chain);
+  }
 
-    if (exchanging_node->left_ != nill_leaf_) {
-      exchanging_node->left_->parent_ = exchanging_node;
+  void DestroyChain(Chain& chain) noexcept {
+    while (chain.head_ != nullptr) {
+      node_type* node = chain.head_;
+      chain.head_ = node->right_;
+      pool_.Destroy(node);
     }
+    chain = Chain{};
+  }
 
-    if (exchanging_node->right_ != nill_leaf_) {
-      exchanging_node->right_->parent_ = exchanging_node;
+  // HELPERS
+  void LinkToParent(node_type* node) noexcept {
+    if (node->Parent()->Parent() == nullptr) {
+      head_ = node;
+    } else if (node->IsLeftChild()) {
+      node->Parent()->left_ = node;
+    } else {
+      node->Parent()->right_ = node;
     }
   }
 
-  // HELPERS
+  void LinkChildren(node_type* node) noexcept {
+    if (node->left_ != nill_leaf_) node->left_->SetParent(node);
+    if (node->right_ != nill_leaf_) node->right_->SetParent(node);
+  }
+
   void CheckColor(node_type* node) noexcept {
-    if (node == head_ || node->parent_ == nullptr) return;
-    if (!node->black_ && !node->parent_->black_) CorrectTree(node);
-    CheckColor(node->parent_);
-  }
-
-  // инструкция, по которой написан код:
-  // https://habr.com/ru/companies/otus/articles/472040/
-  void CorrectTree(node_type* node) noexcept {
-    node_type *parent = node->parent_, *gparent = parent->parent_;
-    if (parent->left_child_) {
-      if (gparent->right_->black_) {
-        if (!node->left_child_) {
-          LeftRotation(parent);
-          std::swap(parent, node);
-        }
-        RightRotation(gparent);
-        if (gparent == head_) head_ = parent;
-        parent->black_ = true;
-        gparent->black_ = false;
-      } else {
-        parent->black_ = true;
-        if (gparent != head_) gparent->black_ = false;
-        gparent->right_->black_ = true;
-        CheckColor(gparent);
+    while (node != head_ && !node->IsBlack() && !node->Parent()->IsBlack()) {
+      node = CorrectTree(node);
+    }
+    head_->SetBlack(true);
+  }
+
+  /*
+  один шаг устранения двух красных подряд
+  возвращает узел, у которого нарушение еще может остаться
+  */
+  node_type* CorrectTree(node_type* node) noexcept {
+    node_type *parent = node->Parent(), *gparent = parent->Parent();
+    node_type* uncle = parent->IsLeftChild() ? gparent->right_ : gparent->left_;
+    if (!uncle->IsBlack()) {
+      parent->SetBlack(true);
+      uncle->SetBlack(true);
+      gparent->SetBlack(false);
+      return gparent;
+    }
+    if (parent->IsLeftChild()) {
+      if (!node->IsLeftChild()) {
+        LeftRotation(parent);
+        std::swap(parent, node);
       }
+      RightRotation(gparent);
     } else {
       // зеркальный случай
-      if (gparent->left_->black_) {
-        if (!node->right_->black_) {
-          RightRotation(parent);
-          std::swap(parent, node);
-        }
-        LeftRotation(gparent);
-        if (gparent == head_) head_ = parent;
-        parent->black_ = true;
-        gparent->black_ = false;
-      } else {
-        parent->black_ = true;
-        if (gparent != head_) gparent->black_ = false;
-        gparent->left_->black_ = true;
-        CheckColor(gparent);
+      if (node->IsLeftChild()) {
+        RightRotation(parent);
+        std::swap(parent, node);
       }
+      LeftRotation(gparent);
     }
-    head_->black_ = true;
+    parent->SetBlack(true);
+    gparent->SetBlack(false);
+    return parent;
   }
 
   /*
@@ -500,94 +1359,158 @@ class RedBlackTree {
   */
   void RightRotation(node_type* node) noexcept {
     node_type* pivot = node->left_;
-    pivot->parent_ = node->parent_;
+    pivot->SetParent(node->Parent());
 
-    if (node->parent_->parent_ == nullptr) {
+    if (node->Parent()->Parent() == nullptr) {
       head_ = pivot;
     } else {
-      if (node->left_child_) {
-        node->parent_->left_ = pivot;
+      if (node->IsLeftChild()) {
+        node->Parent()->left_ = pivot;
       } else {
-        node->parent_->right_ = pivot;
+        node->Parent()->right_ = pivot;
       }
     }
 
-    pivot->left_child_ = node->left_child_;
-    node->left_child_ = false;
-    node->parent_ = pivot;
+    pivot->SetLeftChild(node->IsLeftChild());
+    node->SetLeftChild(false);
+    node->SetParent(pivot);
     node->left_ = pivot->right_;
-    if (node->left_->parent_ != nullptr) node->left_->left_child_ = true;
+    if (node->left_->Parent() != nullptr) node->left_->SetLeftChild(true);
     pivot->right_ = node;
     if (node->left_ != nill_leaf_) {
-      node->left_->parent_ = node;
+      node->left_->SetParent(node);
     }
+    ResizeRotated(node, pivot);
   }
 
   void LeftRotation(node_type* node) noexcept {
     node_type* pivot = node->right_;
-    pivot->parent_ = node->parent_;
+    pivot->SetParent(node->Parent());
 
-    if (node->parent_->parent_ == nullptr) {
+    if (node->Parent()->Parent() == nullptr) {
       head_ = pivot;
     } else {
-      if (node->left_child_) {
-        node->parent_->left_ = pivot;
+      if (node->IsLeftChild()) {
+        node->Parent()->left_ = pivot;
       } else {
-        node->parent_->right_ = pivot;
+        node->Parent()->right_ = pivot;
       }
     }
 
-    pivot->left_child_ = node->left_child_;
-    node->left_child_ = true;
-    node->parent_ = pivot;
+    pivot->SetLeftChild(node->IsLeftChild());
+    node->SetLeftChild(true);
+    node->SetParent(pivot);
     node->right_ = pivot->left_;
-    if (node->right_->parent_ != nullptr) node->right_->left_child_ = false;
+    if (node->right_->Parent() != nullptr) node->right_->SetLeftChild(false);
     pivot->left_ = node;
     if (node->right_ != nill_leaf_) {
-      node->right_->parent_ = node;
+      node->right_->SetParent(node);
     }
+    ResizeRotated(node, pivot);
   }
 
-  void DeleteBranch(node_type* root) noexcept {
+  // the pivot takes over the whole subtree, the lowered node is recounted
+  static void ResizeRotated(node_type* node, node_type* pivot) noexcept {
+    if constexpr (OrderStatistic) {
+      pivot->subtree_size_ = node->subtree_size_;
+      node->subtree_size_ =
+          node->left_->subtree_size_ + node->right_->subtree_size_ + 1;
+    }
+  }
+
+  static node_type* Select(node_type* root, size_type k) noexcept {
+    if (k >= root->subtree_size_) return root->Parent();
+    node_type* cur = root;
+    while (k != cur->left_->subtree_size_) {
+      if (k < cur->left_->subtree_size_) {
+        cur = cur->left_;
+      } else {
+        k -= cur->left_->subtree_size_ + 1;
+        cur = cur->right_;
+      }
+    }
+    return cur;
+  }
+
+  /*
+  climbs from node to the root counting the keys before it, then descends
+  again to the wanted position; the nill stands for position size()
+  */
+  static node_type* Advance(node_type* node, difference_type n) noexcept {
+    static_assert(OrderStatistic,
+                  "iterator arithmetic needs an order-statistic tree");
+    if (n == 0) return node;
+    size_type index = 0;
+    if (node->Parent() == nullptr) {
+      if (node->left_ == nullptr) return node;
+      node = node->left_;
+      while (node->Parent()->Parent() != nullptr) node = node->Parent();
+      index = node->subtree_size_;
+    } else {
+      index = node->left_->subtree_size_;
+      while (node->Parent()->Parent() != nullptr) {
+        if (!node->IsLeftChild()) {
+          index += node->Parent()->left_->subtree_size_ + 1;
+        }
+        node = node->Parent();
+      }
+    }
+    return Select(node, index + n);
+  }
+
+  // runs destructors only, the memory itself goes away with the pool slabs
+  void DestroyBranch(node_type* root) noexcept {
     if (root != nullptr && root != nill_leaf_) {
-      DeleteBranch(root->left_);
-      DeleteBranch(root->right_);
-      delete root;
+      DestroyBranch(root->left_);
+      DestroyBranch(root->right_);
+      root->~node_type();
     }
   }
 
-  class RedBlackTreeNode {
+  class RedBlackTreeNode
+      : public SubtreeSize<OrderStatistic>,
+        public InOrderLinks<Threaded, RedBlackTreeNode> {
    public:
     RedBlackTreeNode() : key_(key_type{}) { MakeDefault(); }
 
     RedBlackTreeNode(const key_type& key) : key_(key) { MakeDefault(); }
 
+    RedBlackTreeNode(key_type&& key) : key_(std::move(key)) { MakeDefault(); }
+
+    template <class... Args>
+    explicit RedBlackTreeNode(std::in_place_t, Args&&... args)
+        : key_(std::forward<Args>(args)...) {
+      MakeDefault();
+    }
+
     RedBlackTreeNode(key_type key, bool isBlack) : RedBlackTreeNode(key) {
-      black_ = isBlack;
+      SetBlack(isBlack);
     }
 
     RedBlackTreeNode(node_type* node)
-        : RedBlackTreeNode(node->key_, node->black_) {
-      left_child_ = node->left_child_;
+        : RedBlackTreeNode(node->key_, node->IsBlack()) {
+      SetLeftChild(node->IsLeftChild());
+      if constexpr (OrderStatistic) {
+        this->subtree_size_ = node->subtree_size_;
+      }
     }
 
-    ~RedBlackTreeNode() { MakeDefault(); }
-
     node_type* NextNode() const {
       node_type* cur = const_cast<node_type*>(this);
+      if constexpr (Threaded) return cur->next_;
       if (cur == nullptr) return cur;
-      if (cur->parent_ == nullptr) return cur->left_;
-      if (cur->right_->parent_ != nullptr) {
+      if (cur->Parent() == nullptr) return cur->left_;
+      if (cur->right_->Parent() != nullptr) {
         cur = cur->right_;
-        while (cur->left_->parent_ != nullptr) {
+        while (cur->left_->Parent() != nullptr) {
           cur = cur->left_;
         }
       } else {
-        while (!cur->left_child_ && cur->parent_ != nullptr) {
-          cur = cur->parent_;
+        while (!cur->IsLeftChild() && cur->Parent() != nullptr) {
+          cur = cur->Parent();
         }
-        if (cur->parent_ != nullptr) {
-          cur = cur->parent_;
+        if (cur->Parent() != nullptr) {
+          cur = cur->Parent();
         }
       }
       return cur;
@@ -595,41 +1518,102 @@ class RedBlackTree {
 
     node_type* PrevNode() const {
       node_type* cur = const_cast<node_type*>(this);
+      if constexpr (Threaded) return cur->prev_;
       if (cur == nullptr) return cur;
-      if (cur->parent_ == nullptr) return cur->right_;
-      if (cur->left_->parent_ != nullptr) {
+      if (cur->Parent() == nullptr) return cur->right_;
+      if (cur->left_->Parent() != nullptr) {
         cur = cur->left_;
-        while (cur->right_->parent_ != nullptr) {
+        while (cur->right_->Parent() != nullptr) {
           cur = cur->right_;
         }
       } else {
-        while (cur->left_child_ && cur->parent_ != nullptr) {
-          cur = cur->parent_;
+        while (cur->IsLeftChild() && cur->Parent() != nullptr) {
+          cur = cur->Parent();
         }
-        if (cur->parent_ != nullptr) {
-          cur = cur->parent_;
+        if (cur->Parent() != nullptr) {
+          cur = cur->Parent();
         }
       }
       return cur;
     }
+
+    node_type* Parent() const noexcept {
+      return reinterpret_cast<node_type*>(parent_bits_ & ~kFlagBits);
+    }
+
+    void SetParent(node_type* parent) noexcept {
+      parent_bits_ =
+          reinterpret_cast<std::uintptr_t>(parent) | (parent_bits_ & kFlagBits);
+    }
+
+    bool IsBlack() const noexcept {
+      if constexpr (Compact) {
+        return parent_bits_ & kBlackBit;
+      } else {
+        return flags_.black_;
+      }
+    }
+
+    void SetBlack(bool black) noexcept {
+      if constexpr (Compact) {
+        parent_bits_ = (parent_bits_ & ~kBlackBit) | (black ? kBlackBit : 0);
+      } else {
+        flags_.black_ = black;
+      }
+    }
+
+    bool IsLeftChild() const noexcept {
+      if constexpr (Compact) {
+        return parent_bits_ & kLeftChildBit;
+      } else {
+        return flags_.left_child_;
+      }
+    }
+
+    void SetLeftChild(bool left) noexcept {
+      if constexpr (Compact) {
+        parent_bits_ =
+            (parent_bits_ & ~kLeftChildBit) | (left ? kLeftChildBit : 0);
+      } else {
+        flags_.left_child_ = left;
+      }
+    }
+
     void MakeDefault() noexcept {
-      parent_ = nullptr;
+      parent_bits_ = 0;
       left_ = nullptr;
       right_ = nullptr;
-      black_ = false;
-      left_child_ = false;
+      if constexpr (!Compact) {
+        flags_.black_ = false;
+        flags_.left_child_ = false;
+      }
+      if constexpr (OrderStatistic) this->subtree_size_ = 1;
+      if constexpr (Threaded) {
+        this->prev_ = nullptr;
+        this->next_ = nullptr;
+      }
     }
 
-    node_type* parent_;
+    // with Compact the colour and the side live in the low parent bits
+    static constexpr std::uintptr_t kBlackBit = Compact ? 1 : 0;
+    static constexpr std::uintptr_t kLeftChildBit = Compact ? 2 : 0;
+    static constexpr std::uintptr_t kFlagBits = kBlackBit | kLeftChildBit;
+
+    std::uintptr_t parent_bits_;
     node_type* left_;
     node_type* right_;
     key_type key_;
-    bool black_;
-    bool left_child_;
+    [[no_unique_address]] NodeFlags<!Compact> flags_;
   };
 
   class RedBlackTreeIterator {
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key*;
+    using reference = Key&;
+
     RedBlackTreeIterator() = delete;
     explicit RedBlackTreeIterator(node_type* node) : node_(node) {}
     RedBlackTreeIterator(const iterator& o) : node_(o.node_) {}
@@ -661,6 +1645,19 @@ class RedBlackTree {
       return *this;
     }
 
+    iterator& operator+=(difference_type n) noexcept {
+      node_ = Advance(node_, n);
+      return *this;
+    }
+
+    iterator operator+(difference_type n) const noexcept {
+      return iterator(Advance(node_, n));
+    }
+
+    iterator operator-(difference_type n) const noexcept {
+      return iterator(Advance(node_, -n));
+    }
+
     reference operator*() noexcept { return node_->key_; }
 
     bool operator==(const iterator& o) const noexcept {
@@ -676,6 +1673,12 @@ class RedBlackTree {
 
   class RedBlackTreeConstIterator {
    public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
     RedBlackTreeConstIterator() = delete;
     RedBlackTreeConstIterator(const const_iterator& o) : node_(o.node_) {}
     explicit RedBlackTreeConstIterator(const node_type* node) : node_(node) {}
@@ -705,6 +1708,19 @@ class RedBlackTree {
 
     const_reference operator*() const noexcept { return node_->key_; }
 
+    const_iterator& operator+=(difference_type n) noexcept {
+      node_ = Advance(const_cast<node_type*>(node_), n);
+      return *this;
+    }
+
+    const_iterator operator+(difference_type n) const noexcept {
+      return const_iterator(Advance(const_cast<node_type*>(node_), n));
+    }
+
+    const_iterator operator-(difference_type n) const noexcept {
+      return const_iterator(Advance(const_cast<node_type*>(node_), -n));
+    }
+
     friend bool operator==(const const_iterator& it1,
                            const const_iterator& it2) noexcept {
       return it1.node_ == it2.node_;
@@ -719,10 +1735,128 @@ class RedBlackTree {
     const node_type* node_;
   };
 
+  // the sentinel lives outside the pool, so clear() keeps it alive
+  node_type* CreateNill() {
+    static_assert(!Compact || alignof(node_type) >= 4,
+                  "compact nodes keep two flags in their parent link");
+    node_allocator_type alloc(pool_.get_allocator());
+    node_type* nill = node_traits::allocate(alloc, 1);
+    ::new (static_cast<void*>(nill)) node_type{};
+    nill->SetBlack(true);
+    if constexpr (OrderStatistic) nill->subtree_size_ = 0;
+    return nill;
+  }
+
+  void DestroyNill() noexcept {
+    node_allocator_type alloc(pool_.get_allocator());
+    nill_leaf_->~node_type();
+    node_traits::deallocate(alloc, nill_leaf_, 1);
+  }
+
   node_type* head_;
   node_type* nill_leaf_;
   size_type size_;
   Comparator is_less_;
+  node_pool_type pool_;
+};
+
+// returns the stored value itself as its key
+struct IdentityKey {
+  template <class T>
+  const T& operator()(const T& value) const noexcept {
+    return value;
+  }
+};
+
+/*
+orders stored values by the keys KeyOfValue extracts from them
+either side may also be a bare key (or anything Compare accepts), so
+lookups never have to build a whole value
+*/
+template <class KeyOfValue, class Compare>
+class ValueComparator {
+ public:
+  ValueComparator() = default;
+
+  ValueComparator(const Compare& is_less) : is_less_(is_less) {}
+
+  template <class Left, class Right>
+  bool operator()(const Left& left, const Right& right) const {
+    return is_less_(KeyOf(left), KeyOf(right));
+  }
+
+  // makes the three-way protocol of Compare reachable through the values
+  template <class Left, class Right>
+  int compare(const Left& left, const Right& right) const {
+    return ThreeWayCompare(is_less_, KeyOf(left), KeyOf(right));
+  }
+
+ private:
+  template <class T>
+  decltype(auto) KeyOf(const T& item) const {
+    if constexpr (std::is_invocable_v<const KeyOfValue&, const T&>) {
+      return key_of_(item);
+    } else {
+      return (item);
+    }
+  }
+
+  [[no_unique_address]] KeyOfValue key_of_;
+  [[no_unique_address]] Compare is_less_;
+};
+
+/*
+backend policy of s21::map and s21::Set
+tree_type is the ordered tree storing Value and ordering it by Key,
+allocating its nodes from Allocator
+*/
+struct RedBlackTreeBackend {
+  template <class Key, class Value, class KeyOfValue, class Compare,
+            class Allocator>
+  using tree_type =
+      RedBlackTree<Value, ValueComparator<KeyOfValue, Compare>, Allocator>;
+};
+
+/*
+RedBlackTreeBackend whose nodes also count their subtrees: map and Set
+gain rank(), select() and iterator + n in O(log n) for one extra word
+per node
+*/
+struct OrderStatisticTreeBackend {
+  template <class Key, class Value, class KeyOfValue, class Compare,
+            class Allocator>
+  using tree_type = RedBlackTree<Value, ValueComparator<KeyOfValue, Compare>,
+                                 Allocator, true>;
+};
+
+/*
+RedBlackTreeBackend whose nodes also link their in-order neighbours:
+iteration steps are one load instead of a climb, for two extra words per
+node; wholesale rebuilds (copies, bulk builds, set algebra) rethread the
+tree in O(n); scans gain most while the nodes stay in cache, on trees far
+larger than the cache the single chain of loads can be slower than the
+climbs
+*/
+struct ThreadedTreeBackend {
+  template <class Key, class Value, class KeyOfValue, class Compare,
+            class Allocator>
+  using tree_type = RedBlackTree<Value, ValueComparator<KeyOfValue, Compare>,
+                                 Allocator, false, true>;
+};
+
+/*
+RedBlackTreeBackend with colour and side packed into the parent link:
+one word less per node whenever the key is a multiple of a word (maps of
+int to int, long or pointer keys, strings)
+nodes of 4-byte keys such as Set<int> stay 32 bytes, the key is padded to
+the pointers either way; for those ArenaTreeBackend is the small layout,
+three 32-bit links and the key make a 16-byte node
+*/
+struct CompactTreeBackend {
+  template <class Key, class Value, class KeyOfValue, class Compare,
+            class Allocator>
+  using tree_type = RedBlackTree<Value, ValueComparator<KeyOfValue, Compare>,
+                                 Allocator, false, false, true>;
 };
 }  // namespace s21
 
@@ -0,0 +1,258 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_CONCURRENT_UNORDERED_MAP_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_CONCURRENT_UNORDERED_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#include "../containers/s21_unordered_map.h"
+
+namespace s21 {
+/*
+hash map for many threads, split in independently locked shards: a key
+belongs to the shard picked by its hash, each shard is an unordered_map
+behind a shared_mutex padded to its own cache line, so threads writing
+to different shards never wait for each other or share a line
+writes take their shard's lock exclusively, reads share it; nothing
+hands out references or iterators into a shard, values are read by
+copy or inside a callback that runs under the lock, and a callback must
+not call back into the same map
+size(), snapshot() and for_each_shard() visit the shards one at a time
+and see each shard at a different moment, not the map at one instant
+*/
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class concurrent_unordered_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using map_type =
+      unordered_map<key_type, mapped_type, hasher, key_equal, allocator_type>;
+
+  static constexpr size_type kDefaultShardCount = 64;
+
+  // shard_count is rounded up to a power of two
+  explicit concurrent_unordered_map(
+      size_type shard_count = kDefaultShardCount,
+      const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+      const allocator_type& alloc = allocator_type())
+      : shard_count_(RoundShardCount(shard_count)),
+        shards_(MakeShards(shard_count_, hash, equal, alloc)),
+        hasher_(hash) {}
+
+  concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+  concurrent_unordered_map& operator=(const concurrent_unordered_map&) =
+      delete;
+  ~concurrent_unordered_map() = default;
+
+  size_type shard_count() const noexcept { return shard_count_; }
+
+  // the shard that holds key
+  size_type shard_of(const key_type& key) const {
+    std::uint64_t hash = static_cast<std::uint64_t>(hasher_(key)) *
+                         std::uint64_t{0x9E3779B97F4A7C15};
+    return static_cast<size_type>(hash >> 32) & (shard_count_ - 1);
+  }
+
+  bool insert(const value_type& value) {
+    Shard& shard = ShardOf(value.first);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.insert(value).second;
+  }
+
+  // mapped_type is built from args only if key is missing
+  template <class... Args>
+  bool try_emplace(const key_type& key, Args&&... args) {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.try_emplace(key, std::forward<Args>(args)...).second;
+  }
+
+  template <class M>
+  bool insert_or_assign(const key_type& key, M&& obj) {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.insert_or_assign(key, std::forward<M>(obj)).second;
+  }
+
+  /*
+  calls fn(mapped_type&) on the value of key under the shard lock, after
+  inserting a value-initialized one if key is missing; returns whether
+  it was inserted, e.g. update_or_insert(k, [](long& n) { ++n; })
+  */
+  template <class Fn>
+  bool update_or_insert(const key_type& key, Fn&& fn) {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    auto result = shard.map_.try_emplace(key);
+    std::forward<Fn>(fn)(result.first->second);
+    return result.second;
+  }
+
+  // calls fn(mapped_type&) under the shard lock only if key is present
+  template <class Fn>
+  bool update(const key_type& key, Fn&& fn) {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) return false;
+    std::forward<Fn>(fn)(it->second);
+    return true;
+  }
+
+  // calls fn(const mapped_type&) under a shared lock if key is present
+  template <class Fn>
+  bool visit(const key_type& key, Fn&& fn) const {
+    const Shard& shard = ShardOf(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    auto it = shard.map_.find(key);
+    if (it == shard.map_.end()) return false;
+    std::forward<Fn>(fn)(it->second);
+    return true;
+  }
+
+  // a copy of the value of key
+  std::optional<mapped_type> get(const key_type& key) const {
+    std::optional<mapped_type> value;
+    visit(key, [&value](const mapped_type& item) { value = item; });
+    return value;
+  }
+
+  bool contains(const key_type& key) const {
+    const Shard& shard = ShardOf(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.contains(key);
+  }
+
+  size_type erase(const key_type& key) {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.map_.erase(key);
+  }
+
+  size_type size() const {
+    size_type count = 0;
+    for_each_shard([&count](const map_type& map) { count += map.size(); });
+    return count;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::unique_lock<std::shared_mutex> lock(shards_[i].mutex_);
+      shards_[i].map_.clear();
+    }
+  }
+
+  // room for n values spread evenly over the shards
+  void reserve(size_type n) {
+    size_type per_shard = n / shard_count_ + n / shard_count_ / 8 + 1;
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::unique_lock<std::shared_mutex> lock(shards_[i].mutex_);
+      shards_[i].map_.reserve(per_shard);
+    }
+  }
+
+  /*
+  calls fn(const map_type&) on every shard in turn, each under its
+  shared lock, e.g. to snapshot or aggregate without stopping writers
+  */
+  template <class Fn>
+  void for_each_shard(Fn&& fn) const {
+    for (size_type i = 0; i < shard_count_; ++i) visit_shard(i, fn);
+  }
+
+  template <class Fn>
+  void visit_shard(size_type index, Fn&& fn) const {
+    std::shared_lock<std::shared_mutex> lock(shards_[index].mutex_);
+    std::forward<Fn>(fn)(shards_[index].map_);
+  }
+
+  // a copy of every value, each shard copied under its own lock
+  map_type snapshot() const {
+    const map_type& first = shards_[0].map_;
+    map_type copy(0, hasher_, first.key_eq(), first.get_allocator());
+    for_each_shard([&copy](const map_type& map) {
+      copy.insert(map.begin(), map.end());
+    });
+    return copy;
+  }
+
+ private:
+  static constexpr size_type kCacheLine = 64;
+
+  struct alignas(kCacheLine) Shard {
+    Shard(const hasher& hash, const key_equal& equal,
+          const allocator_type& alloc)
+        : map_(0, hash, equal, alloc) {}
+
+    mutable std::shared_mutex mutex_;
+    map_type map_;
+  };
+
+  // destroys and frees the shards built by MakeShards
+  class ShardsDeleter {
+   public:
+    explicit ShardsDeleter(size_type count = 0) noexcept : count_(count) {}
+
+    void operator()(Shard* shards) const noexcept {
+      std::destroy_n(shards, count_);
+      std::allocator<Shard>().deallocate(shards, count_);
+    }
+
+   private:
+    size_type count_;
+  };
+
+  using ShardArray = std::unique_ptr<Shard[], ShardsDeleter>;
+
+  // the shards are built in place, so each map keeps hash, equal and alloc
+  static ShardArray MakeShards(size_type count, const hasher& hash,
+                               const key_equal& equal,
+                               const allocator_type& alloc) {
+    Shard* shards = std::allocator<Shard>().allocate(count);
+    size_type built = 0;
+    try {
+      for (; built < count; ++built) {
+        ::new (static_cast<void*>(shards + built)) Shard(hash, equal, alloc);
+      }
+    } catch (...) {
+      std::destroy_n(shards, built);
+      std::allocator<Shard>().deallocate(shards, count);
+      throw;
+    }
+    return ShardArray(shards, ShardsDeleter(count));
+  }
+
+  static size_type RoundShardCount(size_type n) noexcept {
+    size_type count = 1;
+    while (count < n) count *= 2;
+    return count;
+  }
+
+  Shard& ShardOf(const key_type& key) { return shards_[shard_of(key)]; }
+
+  const Shard& ShardOf(const key_type& key) const {
+    return shards_[shard_of(key)];
+  }
+
+  size_type shard_count_;
+  ShardArray shards_;
+  [[no_unique_address]] hasher hasher_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_CONCURRENT_UNORDERED_MAP_H_
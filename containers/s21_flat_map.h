@@ -0,0 +1,647 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_FLAT_MAP_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_FLAT_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../containers/s21_btree.h"
+#include "../containers/s21_vector.h"
+
+namespace s21 {
+
+/*
+first position in [first, first + length) for which is_before is false,
+the elements it holds being true then false; each step halves the length
+and picks the next base with a conditional move rather than a branch, so
+a lookup costs log2(n) + 1 comparisons and no mispredictions
+*/
+template <class RandomIt, class Predicate>
+RandomIt BranchlessPartitionPoint(RandomIt first, std::size_t length,
+                                  Predicate is_before) {
+  while (length > 1U) {
+    std::size_t half = length / 2U;
+    first = is_before(first[half]) ? first + half : first;
+    length -= half;
+  }
+  bool past = length == 1U && is_before(*first);
+  return first + static_cast<std::ptrdiff_t>(past);
+}
+
+/*
+sorted associative array kept as two parallel sorted containers, the keys
+in one and the mapped values in the other: lookups binary search the keys
+alone, which are contiguous, and never touch a value they do not return
+inserting or erasing one element is O(n), so tables are best filled in
+batches by insert_range or the range constructor; iterators are
+invalidated by every insertion and erasure
+*/
+template <class Key, class T, class Compare = std::less<Key>,
+          class KeyContainer = Vector<Key>,
+          class MappedContainer = Vector<T>>
+class flat_map {
+ private:
+  template <bool Const>
+  class Iterator;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = std::pair<const key_type&, mapped_type&>;
+  using const_reference = std::pair<const key_type&, const mapped_type&>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using key_container_type = KeyContainer;
+  using mapped_container_type = MappedContainer;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  flat_map() : keys_(), values_(), comp_() {}
+
+  explicit flat_map(const key_compare& comp)
+      : keys_(), values_(), comp_(comp) {}
+
+  flat_map(std::initializer_list<value_type> const& items,
+           const key_compare& comp = key_compare())
+      : flat_map(comp) {
+    insert_range(items.begin(), items.end());
+  }
+
+  template <class InputIt>
+  flat_map(InputIt first, InputIt last,
+           const key_compare& comp = key_compare())
+      : flat_map(comp) {
+    insert_range(first, last);
+  }
+
+  template <class InputIt>
+  flat_map(sorted_unique_t, InputIt first, InputIt last,
+           const key_compare& comp = key_compare())
+      : flat_map(comp) {
+    assign(sorted_unique, first, last);
+  }
+
+  // adopts containers that are already sorted by key and unique
+  flat_map(sorted_unique_t, key_container_type keys,
+           mapped_container_type values,
+           const key_compare& comp = key_compare())
+      : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {}
+
+  flat_map(const flat_map& other) = default;
+  flat_map(flat_map&& other) = default;
+  ~flat_map() = default;
+  flat_map& operator=(const flat_map& other) = default;
+  flat_map& operator=(flat_map&& other) = default;
+
+  mapped_type& at(const Key& key) {
+    size_type index = FindIndex(key);
+    if (index == size()) {
+      throw std::out_of_range("s21::flat_map::at: key not found");
+    }
+    return values_[index];
+  }
+
+  const mapped_type& at(const Key& key) const {
+    return const_cast<flat_map*>(this)->at(key);
+  }
+
+  mapped_type& operator[](const Key& key) {
+    return (*try_emplace(key).first).second;
+  }
+
+  mapped_type& operator[](Key&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  iterator find(const Key& key) noexcept { return At(FindIndex(key)); }
+
+  const_iterator find(const Key& key) const noexcept {
+    return At(FindIndex(key));
+  }
+
+  // lookup by a type comparable with key_type, e.g. std::string_view
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator find(const K& key) noexcept {
+    return At(FindIndex(key));
+  }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key) const noexcept {
+    return At(FindIndex(key));
+  }
+
+  iterator lower_bound(const Key& key) noexcept {
+    return At(LowerIndex(key));
+  }
+
+  const_iterator lower_bound(const Key& key) const noexcept {
+    return At(LowerIndex(key));
+  }
+
+  iterator upper_bound(const Key& key) noexcept {
+    return At(UpperIndex(key));
+  }
+
+  const_iterator upper_bound(const Key& key) const noexcept {
+    return At(UpperIndex(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) noexcept {
+    size_type first = LowerIndex(key);
+    return {At(first), At(first + (first != size() &&
+                                   !comp_(key, keys_[first])))};
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const noexcept {
+    std::pair<iterator, iterator> items =
+        const_cast<flat_map*>(this)->equal_range(key);
+    return {items.first, items.second};
+  }
+
+  // the elements with keys in [low, high); empty unless low < high
+  IteratorRange<iterator> range(const Key& low, const Key& high) noexcept {
+    iterator first = lower_bound(low);
+    if (!comp_(low, high)) return {first, first};
+    return {first, lower_bound(high)};
+  }
+
+  IteratorRange<const_iterator> range(const Key& low,
+                                      const Key& high) const noexcept {
+    IteratorRange<iterator> items =
+        const_cast<flat_map*>(this)->range(low, high);
+    return {items.begin(), items.end()};
+  }
+
+  iterator begin() noexcept { return At(0U); }
+  iterator end() noexcept { return At(size()); }
+  const_iterator begin() const noexcept { return At(0U); }
+  const_iterator end() const noexcept { return At(size()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  // the sorted keys and their values, index for index
+  const key_container_type& keys() const noexcept { return keys_; }
+  const mapped_container_type& values() const noexcept { return values_; }
+
+  key_compare key_comp() const { return comp_; }
+
+  // replaces the contents; of equivalent keys the first is kept
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    insert_range(first, last);
+  }
+
+  // [first, last) is already sorted by key and unique, O(n)
+  template <class InputIt>
+  void assign(sorted_unique_t, InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first) {
+      keys_.push_back((*first).first);
+      values_.push_back((*first).second);
+    }
+  }
+
+  bool empty() const noexcept { return keys_.empty(); }
+
+  size_type size() const noexcept { return keys_.size(); }
+
+  size_type max_size() const noexcept {
+    return std::min<size_type>(keys_.max_size(), values_.max_size());
+  }
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  void reserve(size_type n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return TryEmplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return TryEmplace(std::move(value.first), std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const mapped_type& obj) {
+    return TryEmplace(key, obj);
+  }
+
+  /*
+  hint is the position the value should go before; when it is right
+  (end() for increasing keys) no search is made
+  */
+  iterator insert(const_iterator hint, const value_type& value) {
+    return HintedEmplace(hint, value.first, value.second);
+  }
+
+  /*
+  the batch is staged, sorted and deduplicated on its own, then merged
+  with the table in one linear pass: O(n + m log m) for m new elements
+  against O(n m) for m single inserts; of equivalent keys the ones
+  already in the table win, then the first of the batch
+  */
+  template <class InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    Vector<value_type> items;
+    for (; first != last; ++first) items.push_back(*first);
+    auto by_key = [this](const value_type& left, const value_type& right) {
+      return comp_(left.first, right.first);
+    };
+    std::stable_sort(items.begin(), items.end(), by_key);
+    items.erase(std::unique(items.begin(), items.end(),
+                            [&by_key](const value_type& left,
+                                      const value_type& right) {
+                              return !by_key(left, right);
+                            }),
+                items.end());
+    MergeSorted(items);
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    std::pair<iterator, bool> result = TryEmplace(key, std::forward<M>(obj));
+    if (!result.second) (*result.first).second = std::forward<M>(obj);
+    return result;
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+    std::pair<iterator, bool> result =
+        TryEmplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) (*result.first).second = std::forward<M>(obj);
+    return result;
+  }
+
+  // mapped_type is built from args only if key is missing
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return TryEmplace(key, std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return TryEmplace(std::move(value.first), std::move(value.second));
+  }
+
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return HintedEmplace(hint, std::move(value.first),
+                         std::move(value.second));
+  }
+
+  iterator erase(const_iterator pos) {
+    size_type index = pos.keys_ - keys_.cbegin();
+    keys_.erase(keys_.begin() + index);
+    values_.erase(values_.begin() + index);
+    return At(index);
+  }
+
+  size_type erase(const Key& key) {
+    size_type index = FindIndex(key);
+    if (index == size()) return 0U;
+    erase(At(index));
+    return 1U;
+  }
+
+  void swap(flat_map& other) noexcept {
+    using std::swap;
+    swap(keys_, other.keys_);
+    swap(values_, other.values_);
+    swap(comp_, other.comp_);
+  }
+
+  // moves in the elements of other whose keys are missing here
+  void merge(flat_map& other) {
+    Vector<value_type> items;
+    size_type kept = 0U;
+    for (size_type i = 0U; i < other.size(); ++i) {
+      if (contains(other.keys_[i])) {
+        other.MoveElement(i, kept++);
+      } else {
+        items.push_back(value_type(std::move(other.keys_[i]),
+                                   std::move(other.values_[i])));
+      }
+    }
+    other.Truncate(kept);
+    MergeSorted(items);
+  }
+
+  // set algebra by key in place, the values kept are ours
+  void unite(const flat_map& other) {
+    Vector<value_type> items;
+    for (size_type i = 0U; i < other.size(); ++i) {
+      if (!contains(other.keys_[i])) {
+        items.push_back(value_type(other.keys_[i], other.values_[i]));
+      }
+    }
+    MergeSorted(items);
+  }
+
+  void intersect(const flat_map& other) { Retain(other, true); }
+  void subtract(const flat_map& other) { Retain(other, false); }
+
+  bool contains(const Key& key) const noexcept {
+    return FindIndex(key) != size();
+  }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return FindIndex(key) != size();
+  }
+
+  // order statistics come free with the sorted layout
+  size_type rank(const Key& key) const noexcept { return LowerIndex(key); }
+
+  iterator select(size_type k) noexcept { return At(k); }
+  const_iterator select(size_type k) const noexcept { return At(k); }
+
+ private:
+  // the reference is a pair of references into the two containers
+  template <bool Const>
+  class Iterator {
+   private:
+    using key_iterator = typename KeyContainer::const_iterator;
+    using mapped_iterator =
+        std::conditional_t<Const, typename MappedContainer::const_iterator,
+                           typename MappedContainer::iterator>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = flat_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, flat_map::const_reference,
+                                         flat_map::reference>;
+
+    // operator-> returns the reference pair by value
+    class pointer {
+     public:
+      explicit pointer(reference value) : value_(value) {}
+      reference* operator->() noexcept { return &value_; }
+
+     private:
+      reference value_;
+    };
+
+    Iterator() = default;
+
+    Iterator(key_iterator keys, mapped_iterator values)
+        : keys_(keys), values_(values) {}
+
+    // iterator converts to const_iterator
+    template <bool C = Const, class = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& other)
+        : keys_(other.keys_), values_(other.values_) {}
+
+    reference operator*() const { return reference(*keys_, *values_); }
+    pointer operator->() const { return pointer(**this); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    Iterator& operator++() {
+      ++keys_;
+      ++values_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    Iterator& operator--() {
+      --keys_;
+      --values_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    Iterator& operator+=(difference_type n) {
+      keys_ += n;
+      values_ += n;
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) { return *this += -n; }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+
+    friend difference_type operator-(const Iterator& left,
+                                     const Iterator& right) {
+      return left.keys_ - right.keys_;
+    }
+
+    friend bool operator==(const Iterator& left, const Iterator& right) {
+      return left.keys_ == right.keys_;
+    }
+
+    friend bool operator!=(const Iterator& left, const Iterator& right) {
+      return left.keys_ != right.keys_;
+    }
+
+    friend bool operator<(const Iterator& left, const Iterator& right) {
+      return left.keys_ < right.keys_;
+    }
+
+    friend bool operator>(const Iterator& left, const Iterator& right) {
+      return right < left;
+    }
+
+    friend bool operator<=(const Iterator& left, const Iterator& right) {
+      return !(right < left);
+    }
+
+    friend bool operator>=(const Iterator& left, const Iterator& right) {
+      return !(left < right);
+    }
+
+   private:
+    friend class flat_map;
+    template <bool>
+    friend class Iterator;
+
+    key_iterator keys_;
+    mapped_iterator values_;
+  };
+
+  iterator At(size_type index) noexcept {
+    return iterator(keys_.cbegin() + index, values_.begin() + index);
+  }
+
+  const_iterator At(size_type index) const noexcept {
+    return const_iterator(keys_.cbegin() + index, values_.cbegin() + index);
+  }
+
+  template <class K>
+  size_type LowerIndex(const K& key) const noexcept {
+    return BranchlessPartitionPoint(keys_.cbegin(), size(),
+                                    [this, &key](const Key& item) {
+                                      return comp_(item, key);
+                                    }) -
+           keys_.cbegin();
+  }
+
+  template <class K>
+  size_type UpperIndex(const K& key) const noexcept {
+    return BranchlessPartitionPoint(keys_.cbegin(), size(),
+                                    [this, &key](const Key& item) {
+                                      return !comp_(key, item);
+                                    }) -
+           keys_.cbegin();
+  }
+
+  // size() when the key is missing
+  template <class K>
+  size_type FindIndex(const K& key) const noexcept {
+    size_type index = LowerIndex(key);
+    if (index != size() && comp_(key, keys_[index])) return size();
+    return index;
+  }
+
+  template <class K, class... Args>
+  iterator EmplaceAt(size_type index, K&& key, Args&&... args) {
+    keys_.insert(keys_.cbegin() + index, std::forward<K>(key));
+    try {
+      values_.emplace(values_.cbegin() + index, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.cbegin() + index);
+      throw;
+    }
+    return At(index);
+  }
+
+  template <class K, class... Args>
+  std::pair<iterator, bool> TryEmplace(K&& key, Args&&... args) {
+    size_type index = LowerIndex(key);
+    if (index != size() && !comp_(key, keys_[index])) {
+      return {At(index), false};
+    }
+    return {EmplaceAt(index, std::forward<K>(key),
+                      std::forward<Args>(args)...),
+            true};
+  }
+
+  template <class K, class M>
+  iterator HintedEmplace(const_iterator hint, K&& key, M&& obj) {
+    size_type index = hint.keys_ - keys_.cbegin();
+    if ((index == 0U || comp_(keys_[index - 1U], key)) &&
+        (index == size() || comp_(key, keys_[index]))) {
+      return EmplaceAt(index, std::forward<K>(key), std::forward<M>(obj));
+    }
+    return TryEmplace(std::forward<K>(key), std::forward<M>(obj)).first;
+  }
+
+  // items are sorted and unique; the table is cleared if a move throws
+  void MergeSorted(Vector<value_type>& items) {
+    if (items.empty()) return;
+    try {
+      if (empty() || comp_(keys_.back(), items.front().first)) {
+        reserve(size() + items.size());
+        for (value_type& item : items) {
+          keys_.push_back(std::move(item.first));
+          values_.push_back(std::move(item.second));
+        }
+        return;
+      }
+      key_container_type keys;
+      mapped_container_type values;
+      keys.reserve(size() + items.size());
+      values.reserve(size() + items.size());
+      auto item = items.begin();
+      for (size_type i = 0U; i < size() || item != items.end();) {
+        if (item == items.end() ||
+            (i < size() && !comp_(item->first, keys_[i]))) {
+          if (item != items.end() && !comp_(keys_[i], item->first)) ++item;
+          keys.push_back(std::move(keys_[i]));
+          values.push_back(std::move(values_[i]));
+          ++i;
+        } else {
+          keys.push_back(std::move(item->first));
+          values.push_back(std::move(item->second));
+          ++item;
+        }
+      }
+      keys_ = std::move(keys);
+      values_ = std::move(values);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  void MoveElement(size_type from, size_type to) {
+    if (from == to) return;
+    keys_[to] = std::move(keys_[from]);
+    values_[to] = std::move(values_[from]);
+  }
+
+  void Truncate(size_type n) {
+    keys_.erase(keys_.cbegin() + n, keys_.cend());
+    values_.erase(values_.cbegin() + n, values_.cend());
+  }
+
+  // keeps the elements whose keys are (or are not) in other, O(n + m)
+  void Retain(const flat_map& other, bool in_other) {
+    size_type kept = 0U;
+    size_type j = 0U;
+    for (size_type i = 0U; i < size(); ++i) {
+      while (j < other.size() && comp_(other.keys_[j], keys_[i])) ++j;
+      bool common = j < other.size() && !comp_(keys_[i], other.keys_[j]);
+      if (common == in_other) MoveElement(i, kept++);
+    }
+    Truncate(kept);
+  }
+
+  key_container_type keys_;
+  mapped_container_type values_;
+  [[no_unique_address]] key_compare comp_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_FLAT_MAP_H_
@@ -0,0 +1,339 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_FLAT_SET_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_FLAT_SET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "../containers/s21_btree.h"
+#include "../containers/s21_flat_map.h"
+#include "../containers/s21_vector.h"
+
+namespace s21 {
+
+/*
+sorted set kept in one sorted container, searched by
+BranchlessPartitionPoint; single insertions and erasures are O(n), so
+sets are best filled in batches by insert_range or the range constructor
+iterators are invalidated by every insertion and erasure
+*/
+template <class Key, class Compare = std::less<Key>,
+          class KeyContainer = Vector<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using container_type = KeyContainer;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  flat_set() : keys_(), comp_() {}
+
+  explicit flat_set(const key_compare &comp) : keys_(), comp_(comp) {}
+
+  flat_set(std::initializer_list<value_type> const &list,
+           const key_compare &comp = key_compare())
+      : flat_set(comp) {
+    insert_range(list.begin(), list.end());
+  }
+
+  template <class InputIt>
+  flat_set(InputIt first, InputIt last,
+           const key_compare &comp = key_compare())
+      : flat_set(comp) {
+    insert_range(first, last);
+  }
+
+  template <class InputIt>
+  flat_set(sorted_unique_t, InputIt first, InputIt last,
+           const key_compare &comp = key_compare())
+      : flat_set(comp) {
+    assign(sorted_unique, first, last);
+  }
+
+  // adopts a container that is already sorted and unique
+  flat_set(sorted_unique_t, container_type keys,
+           const key_compare &comp = key_compare())
+      : keys_(std::move(keys)), comp_(comp) {}
+
+  flat_set(const flat_set &other) = default;
+  flat_set(flat_set &&other) = default;
+  flat_set &operator=(const flat_set &other) = default;
+  flat_set &operator=(flat_set &&other) = default;
+  ~flat_set() = default;
+
+  // replaces the contents; of equivalent keys the first is kept
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    insert_range(first, last);
+  }
+
+  // [first, last) is already sorted and unique, O(n)
+  template <class InputIt>
+  void assign(sorted_unique_t, InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first) keys_.push_back(*first);
+  }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+
+  std::pair<iterator, bool> insert(const value_type &val) {
+    return EmplaceUnique(val);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&val) {
+    return EmplaceUnique(std::move(val));
+  }
+
+  /*
+  hint is the position the value should go before; when it is right
+  (end() for increasing keys) no search is made
+  */
+  iterator insert(const_iterator hint, const value_type &val) {
+    return HintedEmplace(hint, val);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return EmplaceUnique(value_type(std::forward<Args>(args)...));
+  }
+
+  template <class... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    return HintedEmplace(hint, value_type(std::forward<Args>(args)...));
+  }
+
+  /*
+  the batch is staged, sorted and deduplicated on its own, then merged
+  with the set in one linear pass, O(n + m log m) for m new keys
+  */
+  template <class InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    container_type items;
+    for (; first != last; ++first) items.push_back(*first);
+    std::stable_sort(items.begin(), items.end(), comp_);
+    items.erase(std::unique(items.begin(), items.end(),
+                            [this](const value_type &left,
+                                   const value_type &right) {
+                              return !comp_(left, right);
+                            }),
+                items.end());
+    MergeSorted(items);
+  }
+
+  iterator find(const key_type &key) const noexcept {
+    return keys_.cbegin() + FindIndex(key);
+  }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator find(const K &key) const noexcept {
+    return keys_.cbegin() + FindIndex(key);
+  }
+
+  iterator lower_bound(const key_type &key) const noexcept {
+    return keys_.cbegin() + LowerIndex(key);
+  }
+
+  iterator upper_bound(const key_type &key) const noexcept {
+    return BranchlessPartitionPoint(
+        keys_.cbegin(), size(),
+        [this, &key](const key_type &item) { return !comp_(key, item); });
+  }
+
+  std::pair<iterator, iterator> equal_range(
+      const key_type &key) const noexcept {
+    iterator first = lower_bound(key);
+    bool found = first != keys_.cend() && !comp_(key, *first);
+    return {first, first + static_cast<std::ptrdiff_t>(found)};
+  }
+
+  // the keys in [low, high); empty unless low < high
+  IteratorRange<iterator> range(const key_type &low,
+                                const key_type &high) const noexcept {
+    iterator first = lower_bound(low);
+    if (!comp_(low, high)) return {first, first};
+    return {first, lower_bound(high)};
+  }
+
+  bool contains(const key_type &key) const noexcept {
+    return FindIndex(key) != size();
+  }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  bool contains(const K &key) const noexcept {
+    return FindIndex(key) != size();
+  }
+
+  iterator erase(const_iterator iter) { return keys_.erase(iter); }
+
+  size_type erase(const key_type &key) {
+    size_type index = FindIndex(key);
+    if (index == size()) return 0U;
+    keys_.erase(keys_.cbegin() + index);
+    return 1U;
+  }
+
+  // order statistics come free with the sorted layout
+  size_type rank(const key_type &key) const noexcept {
+    return LowerIndex(key);
+  }
+
+  iterator select(size_type k) const noexcept { return keys_.cbegin() + k; }
+
+  // the sorted keys
+  const container_type &keys() const noexcept { return keys_; }
+
+  key_compare key_comp() const { return comp_; }
+
+  void clear() noexcept { keys_.clear(); }
+  void reserve(size_type n) { keys_.reserve(n); }
+
+  void swap(flat_set &other) noexcept {
+    using std::swap;
+    swap(keys_, other.keys_);
+    swap(comp_, other.comp_);
+  }
+
+  // moves in the keys of other that are missing here
+  void merge(flat_set &other) {
+    container_type items;
+    size_type kept = 0U;
+    for (size_type i = 0U; i < other.size(); ++i) {
+      if (contains(other.keys_[i])) {
+        if (kept != i) other.keys_[kept] = std::move(other.keys_[i]);
+        ++kept;
+      } else {
+        items.push_back(std::move(other.keys_[i]));
+      }
+    }
+    other.keys_.erase(other.keys_.cbegin() + kept, other.keys_.cend());
+    MergeSorted(items);
+  }
+
+  // set algebra in place, each in one linear pass
+  void unite(const flat_set &other) {
+    container_type items;
+    for (auto key = other.keys_.cbegin(); key != other.keys_.cend(); ++key) {
+      if (!contains(*key)) items.push_back(*key);
+    }
+    MergeSorted(items);
+  }
+
+  void intersect(const flat_set &other) { Retain(other, true); }
+  void subtract(const flat_set &other) { Retain(other, false); }
+
+  iterator begin() const noexcept { return keys_.cbegin(); }
+  iterator end() const noexcept { return keys_.cend(); }
+  const_iterator cbegin() const noexcept { return keys_.cbegin(); }
+  const_iterator cend() const noexcept { return keys_.cend(); }
+
+  reverse_iterator rbegin() const noexcept {
+    return reverse_iterator(end());
+  }
+  reverse_iterator rend() const noexcept {
+    return reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(cend());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(cbegin());
+  }
+
+ private:
+  template <class K>
+  size_type LowerIndex(const K &key) const noexcept {
+    return BranchlessPartitionPoint(
+               keys_.cbegin(), size(),
+               [this, &key](const key_type &item) {
+                 return comp_(item, key);
+               }) -
+           keys_.cbegin();
+  }
+
+  // size() when the key is missing
+  template <class K>
+  size_type FindIndex(const K &key) const noexcept {
+    size_type index = LowerIndex(key);
+    if (index != size() && comp_(key, keys_[index])) return size();
+    return index;
+  }
+
+  template <class V>
+  std::pair<iterator, bool> EmplaceUnique(V &&val) {
+    size_type index = LowerIndex(val);
+    if (index != size() && !comp_(val, keys_[index])) {
+      return {keys_.cbegin() + index, false};
+    }
+    return {keys_.insert(keys_.cbegin() + index, std::forward<V>(val)), true};
+  }
+
+  template <class V>
+  iterator HintedEmplace(const_iterator hint, V &&val) {
+    size_type index = hint - keys_.cbegin();
+    if ((index == 0U || comp_(keys_[index - 1U], val)) &&
+        (index == size() || comp_(val, keys_[index]))) {
+      return keys_.insert(hint, std::forward<V>(val));
+    }
+    return EmplaceUnique(std::forward<V>(val)).first;
+  }
+
+  // items are sorted and unique; the set is cleared if a move throws
+  void MergeSorted(container_type &items) {
+    if (items.empty()) return;
+    try {
+      if (empty() || comp_(keys_.back(), items.front())) {
+        keys_.reserve(size() + items.size());
+        for (value_type &item : items) keys_.push_back(std::move(item));
+        return;
+      }
+      container_type keys;
+      keys.reserve(size() + items.size());
+      auto item = items.begin();
+      for (size_type i = 0U; i < size() || item != items.end();) {
+        if (item == items.end() || (i < size() && !comp_(*item, keys_[i]))) {
+          if (item != items.end() && !comp_(keys_[i], *item)) ++item;
+          keys.push_back(std::move(keys_[i++]));
+        } else {
+          keys.push_back(std::move(*item++));
+        }
+      }
+      keys_ = std::move(keys);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  // keeps the keys that are (or are not) in other, O(n + m)
+  void Retain(const flat_set &other, bool in_other) {
+    size_type kept = 0U;
+    size_type j = 0U;
+    for (size_type i = 0U; i < size(); ++i) {
+      while (j < other.size() && comp_(other.keys_[j], keys_[i])) ++j;
+      bool common = j < other.size() && !comp_(keys_[i], other.keys_[j]);
+      if (common != in_other) continue;
+      if (kept != i) keys_[kept] = std::move(keys_[i]);
+      ++kept;
+    }
+    keys_.erase(keys_.cbegin() + kept, keys_.cend());
+  }
+
+  container_type keys_;
+  [[no_unique_address]] key_compare comp_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_FLAT_SET_H_
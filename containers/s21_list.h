@@ -3,12 +3,22 @@
 
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <utility>
 
 namespace s21 {
-template <class T>
+/*
+nodes and the sentinel are allocated from Allocator rebound to the node
+type, copies, moves and swaps follow the std allocator propagation traits
+*/
+template <class T, class Allocator = std::allocator<T>>
 class list {
  private:
   class ListNode;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using node_allocator_type =
+      typename alloc_traits::template rebind_alloc<ListNode>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
 
  public:
   class ListIterator;
@@ -17,48 +27,87 @@ class list {
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
-  using iterator = list<value_type>::ListIterator;
-  using const_iterator = list<value_type>::ListConstIterator;
+  using iterator = ListIterator;
+  using const_iterator = ListConstIterator;
   using size_type = std::size_t;
   using node_type = ListNode;
+  using allocator_type = Allocator;
 
-  list() : head_(new node_type{}), size_(size_type{}) {}
+  list() : list(allocator_type()) {}
+
+  explicit list(const allocator_type &alloc)
+      : head_(nullptr), size_(size_type{}), node_alloc_(alloc) {
+    head_ = CreateNode();
+  }
 
   explicit list(size_type n) : list() {
     for (; n > 0; n--, push_back(value_type{}))
       ;
   }
 
-  list(std::initializer_list<value_type> const &items) : list() {
+  list(std::initializer_list<value_type> const &items,
+       const allocator_type &alloc = allocator_type())
+      : list(alloc) {
     for (auto item : items) {
       push_back(item);
     }
   }
 
-  list(const list &l) : list() {
+  list(const list &l)
+      : list(alloc_traits::select_on_container_copy_construction(
+            l.get_allocator())) {
     for (auto it = l.begin(); it != l.end(); ++it) {
       push_back(*it);
     }
   }
 
-  list(list &&l) : list() { splice(begin(), l); }
+  list(list &&l) : list(l.get_allocator()) { splice(begin(), l); }
 
   ~list() {
     clear();
-    delete head_;
+    DestroyNode(head_);
     head_ = nullptr;
   }
 
+  /*
+  nodes are stolen when the allocator of l comes along or is equal to ours,
+  otherwise the values are moved one by one into our own nodes
+  */
   list &operator=(list &&l) {
     if (this != &l) {
       clear();
-      splice(begin(), l);
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        std::swap(head_, l.head_);
+        std::swap(size_, l.size_);
+        std::swap(node_alloc_, l.node_alloc_);
+      } else {
+        if (node_alloc_ == l.node_alloc_) {
+          splice(begin(), l);
+        } else {
+          for (iterator it = l.begin(); it != l.end(); ++it) {
+            head_->BindBeforeCurrent(CreateNode(std::move(*it)));
+            ++size_;
+          }
+          l.clear();
+        }
+      }
     }
     return *this;
   }
 
   list &operator=(const list &other) {
     if (this != &other) {
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (node_alloc_ != other.node_alloc_) {
+          clear();
+          DestroyNode(head_);
+          head_ = nullptr;
+          node_alloc_ = other.node_alloc_;
+          head_ = CreateNode();
+        }
+      }
       iterator tbegin = begin(), tend = end();
       const_iterator obegin = other.begin(), oend = other.end();
 
@@ -97,6 +146,10 @@ class list {
   const_iterator begin() const noexcept { return const_iterator(head_->next_); }
   const_iterator end() const noexcept { return const_iterator(head_); }
 
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(node_alloc_);
+  }
+
   bool empty() const noexcept { return size_ == 0; }
 
   size_type size() const noexcept { return size_; }
@@ -110,7 +163,7 @@ class list {
     }
   }
   iterator insert(iterator pos, const_reference value) {
-    node_type *new_node = new node_type(value);
+    node_type *new_node = CreateNode(value);
 
     pos.node_->BindBeforeCurrent(new_node);
     ++size_;
@@ -120,7 +173,7 @@ class list {
   void erase(iterator pos) noexcept {
     if (pos.node_ != head_) {
       pos.node_->Unbind();
-      delete pos.node_;
+      DestroyNode(pos.node_);
       --size_;
     }
   }
@@ -132,6 +185,9 @@ class list {
   void swap(list &other) noexcept {
     std::swap(head_, other.head_);
     std::swap(size_, other.size_);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(node_alloc_, other.node_alloc_);
+    }
   }
   void merge(list &other) noexcept {
     if (this != &other) {
@@ -316,6 +372,8 @@ class list {
     ListNode() : next_(this), prev_(this), data_(value_type{}) {}
     explicit ListNode(const_reference value)
         : next_(nullptr), prev_(nullptr), data_(value) {}
+    explicit ListNode(value_type &&value)
+        : next_(nullptr), prev_(nullptr), data_(std::move(value)) {}
 
     void BindBeforeCurrent(ListNode *new_node) noexcept {
       new_node->next_ = this;
@@ -336,8 +394,26 @@ class list {
     value_type data_;
   };
 
+  template <class... Args>
+  node_type *CreateNode(Args &&...args) {
+    node_type *node = node_traits::allocate(node_alloc_, 1);
+    try {
+      node_traits::construct(node_alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(node_alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void DestroyNode(node_type *node) noexcept {
+    node_traits::destroy(node_alloc_, node);
+    node_traits::deallocate(node_alloc_, node, 1);
+  }
+
   ListNode *head_;
   size_type size_;
+  [[no_unique_address]] node_allocator_type node_alloc_;
 };
 
 }  // namespace s21
@@ -1,15 +1,32 @@
 #ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_MAP_H_
 #define CPP2_S21_CONTAINERS_CONTAINERS_S21_MAP_H_
 
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "../containers/s21_btree.h"
+#include "../containers/s21_node_handle.h"
 
 namespace s21 {
-template <class Key, class T>
+/*
+Compare orders the keys; a Compare with a member compare(a, b) returning
+a negative, zero or positive int is asked once per tree level (see
+ThreeWayCompare), and a transparent one (is_transparent) enables lookups
+by any type it can order against Key
+*/
+template <class Key, class T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>,
+          class Backend = RedBlackTreeBackend>
 class map {
  private:
-  class Comparator;
+  class KeyOfValue;
 
  public:
   using key_type = Key;
@@ -18,40 +35,75 @@ class map {
   using reference = value_type&;
   using const_reference = const value_type&;
   using size_type = std::size_t;
-  using tree_type = RedBlackTree<value_type, Comparator>;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using tree_type = typename Backend::template tree_type<
+      key_type, value_type, KeyOfValue, key_compare, allocator_type>;
   using iterator = typename tree_type::iterator;
   using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using node_type = MapNodeHandle<key_type, mapped_type, allocator_type>;
+  using insert_return_type = NodeInsertReturn<iterator, node_type>;
 
-  map() : body_(new tree_type{}) {}
+  map() : body_() {}
 
-  map(std::initializer_list<value_type> const& items) : map() {
+  explicit map(const allocator_type& alloc) : body_(alloc) {}
+
+  explicit map(const key_compare& comp,
+               const allocator_type& alloc = allocator_type())
+      : body_(comp, alloc) {}
+
+  map(std::initializer_list<value_type> const& items,
+      const key_compare& comp = key_compare(),
+      const allocator_type& alloc = allocator_type())
+      : map(comp, alloc) {
     for (auto item : items) {
       insert(item);
     }
   }
 
-  map(const map& m) : body_(new tree_type{*m.body_}) {}
+  map(std::initializer_list<value_type> const& items,
+      const allocator_type& alloc)
+      : map(items, key_compare(), alloc) {}
 
-  map(map&& m) : body_(new tree_type{std::move(*m.body_)}) {}
+  template <class InputIt>
+  map(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+      const allocator_type& alloc = allocator_type())
+      : map(comp, alloc) {
+    assign(first, last);
+  }
 
-  ~map() {
-    delete body_;
-    body_ = nullptr;
+  template <class ForwardIt>
+  map(sorted_unique_t, ForwardIt first, ForwardIt last,
+      const key_compare& comp = key_compare(),
+      const allocator_type& alloc = allocator_type())
+      : map(comp, alloc) {
+    body_.BuildSorted(first, last);
   }
 
-  map& operator=(map& m) {
-    *body_ = *m.body_;
+  map(const map& m) : body_(m.body_) {}
+
+  map(map&& m) : body_(std::move(m.body_)) {}
+
+  ~map() = default;
+
+  map& operator=(const map& m) {
+    body_ = m.body_;
     return *this;
   }
 
   map& operator=(map&& m) {
-    *body_ = std::move(*m.body_);
+    body_ = std::move(m.body_);
     return *this;
   }
 
+  allocator_type get_allocator() const noexcept {
+    return body_.get_allocator();
+  }
+
   mapped_type& at(const Key& key) {
-    value_type val(key, mapped_type{});
-    iterator it = body_->find(val);
+    iterator it = body_.find(key);
     if (it == end()) {
       throw std::out_of_range("s21::map::at: key not found");
     }
@@ -59,77 +111,260 @@ class map {
   }
 
   const mapped_type& at(const Key& key) const {
-    return const_cast<map<Key, T>*>(this)->at(key);
+    return const_cast<map*>(this)->at(key);
   }
 
-  mapped_type& operator[](const Key& key) noexcept {
-    value_type val(key, mapped_type{});
-    iterator it = body_->find(val);
+  // one descent; mapped_type is value-initialized only for a new key
+  mapped_type& operator[](const Key& key) {
+    return (*try_emplace(key).first).second;
+  }
 
-    if (it == end()) {
-      std::pair<iterator, bool> result = body_->insert(val);
-      return (*result.first).second;
-    } else {
-      return (*it).second;
-    }
+  mapped_type& operator[](Key&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
+
+  iterator find(const Key& key) noexcept { return body_.find(key); }
+
+  const_iterator find(const Key& key) const noexcept {
+    return body_.find(key);
+  }
+
+  // lookup by a type comparable with key_type, e.g. std::string_view
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator find(const K& key) noexcept {
+    return body_.find(key);
   }
 
-  iterator find(const Key& key) noexcept {
-    value_type val(key, mapped_type{});
-    return body_->find(val);
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  const_iterator find(const K& key) const noexcept {
+    return body_.find(key);
   }
-  iterator begin() noexcept { return body_->begin(); }
-  iterator end() noexcept { return body_->end(); }
-  const_iterator begin() const noexcept { return body_->begin(); }
-  const_iterator end() const noexcept { return body_->end(); }
 
-  bool empty() const noexcept { return body_->empty(); }
+  iterator lower_bound(const Key& key) noexcept {
+    return body_.lower_bound(key);
+  }
+
+  const_iterator lower_bound(const Key& key) const noexcept {
+    return body_.lower_bound(key);
+  }
 
-  size_type size() const noexcept { return body_->size(); }
+  iterator upper_bound(const Key& key) noexcept {
+    return body_.upper_bound(key);
+  }
 
-  size_type max_size() const noexcept { return body_->max_size(); }
+  const_iterator upper_bound(const Key& key) const noexcept {
+    return body_.upper_bound(key);
+  }
 
-  void clear() noexcept { body_->clear(); }
+  std::pair<iterator, iterator> equal_range(const Key& key) noexcept {
+    return body_.equal_range(key);
+  }
 
-  std::pair<iterator, bool> insert(const value_type& value) noexcept {
-    return body_->insert(value);
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key& key) const noexcept {
+    return body_.equal_range(key);
   }
 
-  std::pair<iterator, bool> insert(const Key& key,
-                                   const mapped_type& obj) noexcept {
-    return body_->insert(value_type{key, obj});
+  /*
+  the elements with keys in [low, high), found in two descents and then
+  walked lazily; empty unless low < high
+  */
+  IteratorRange<iterator> range(const Key& low, const Key& high) noexcept {
+    iterator first = body_.lower_bound(low);
+    if (!body_.key_comp()(low, high)) return {first, first};
+    return {first, body_.lower_bound(high)};
   }
 
-  std::pair<iterator, bool> insert_or_assign(const Key& key,
-                                             const mapped_type& obj) noexcept {
-    iterator result = body_->find(value_type{key, obj});
+  IteratorRange<const_iterator> range(const Key& low,
+                                      const Key& high) const noexcept {
+    IteratorRange<iterator> items = const_cast<map*>(this)->range(low, high);
+    return {items.begin(), items.end()};
+  }
 
-    if (result == end()) {
-      return body_->insert(value_type{key, obj});
-    }
+  iterator begin() noexcept { return body_.begin(); }
+  iterator end() noexcept { return body_.end(); }
+  const_iterator begin() const noexcept { return body_.begin(); }
+  const_iterator end() const noexcept { return body_.end(); }
+
+  // backwards from the cached maximum
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  /*
+  replaces the contents in O(n log n): a copy of the range is sorted by
+  key and the tree is built from it in O(n); of equivalent keys the first
+  is kept
+  */
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    using item_type = std::pair<key_type, mapped_type>;
+    using item_allocator_type = typename std::allocator_traits<
+        allocator_type>::template rebind_alloc<item_type>;
+    std::vector<item_type, item_allocator_type> items(
+        first, last, item_allocator_type(get_allocator()));
+    auto is_less = body_.key_comp();
+    auto by_key = [&is_less](const item_type& left, const item_type& right) {
+      return is_less(left.first, right.first);
+    };
+    std::stable_sort(items.begin(), items.end(), by_key);
+    items.erase(std::unique(items.begin(), items.end(),
+                            [&by_key](const item_type& left,
+                                      const item_type& right) {
+                              return !by_key(left, right);
+                            }),
+                items.end());
+    body_.BuildSorted(std::make_move_iterator(items.begin()),
+                      std::make_move_iterator(items.end()));
+  }
+
+  // [first, last) is already sorted by key and unique, O(n)
+  template <class ForwardIt>
+  void assign(sorted_unique_t, ForwardIt first, ForwardIt last) {
+    body_.BuildSorted(first, last);
+  }
+
+  bool empty() const noexcept { return body_.empty(); }
 
-    (*result).second = obj;
-    return std::pair(result, false);
+  size_type size() const noexcept { return body_.size(); }
+
+  size_type max_size() const noexcept { return body_.max_size(); }
+
+  void clear() noexcept { body_.clear(); }
+
+  void reserve(size_type n) { body_.reserve(n); }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return body_.EmplaceUnique(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const mapped_type& obj) {
+    return body_.EmplaceUnique(key, key, obj);
+  }
+
+  /*
+  hint is the position the value should go before; when it is right
+  (end() for increasing keys) no descent from the root is made
+  */
+  iterator insert(iterator hint, const value_type& value) {
+    return body_.EmplaceHint(hint, value.first, value).first;
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    std::pair<iterator, bool> result =
+        body_.EmplaceUnique(key, key, std::forward<M>(obj));
+    if (!result.second) (*result.first).second = std::forward<M>(obj);
+    return result;
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+    std::pair<iterator, bool> result =
+        body_.EmplaceUnique(key, std::move(key), std::forward<M>(obj));
+    if (!result.second) (*result.first).second = std::forward<M>(obj);
+    return result;
+  }
+
+  // mapped_type is built from args only if key is missing
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return body_.EmplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return body_.EmplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
-  void erase(iterator pos) noexcept { body_->erase(pos); }
+  // builds the whole value first, as its key is not known before
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return body_.emplace(std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return body_.EmplaceHint(hint, value.first, std::move(value)).first;
+  }
+
+  void erase(iterator pos) noexcept { body_.erase(pos); }
+
+  /*
+  node handles move an entry between maps, or out and back in under a new
+  key, moving both its key and its mapped value and never copying them
+  */
+  node_type extract(iterator pos) {
+    return node_type(
+        body_.template Extract<std::pair<key_type, mapped_type>>(pos),
+        get_allocator());
+  }
+
+  node_type extract(const key_type& key) {
+    iterator pos = body_.find(key);
+    if (pos == body_.end()) return node_type();
+    return extract(pos);
+  }
 
-  void swap(map& other) noexcept { body_->swap(*other.body_); }
-  void merge(map& other) noexcept { body_->merge(*other.body_); }
-  bool contains(const Key& key) noexcept {
-    return body_->contains({key, mapped_type{}});
+  insert_return_type insert(node_type&& node) {
+    if (node.empty()) return {end(), false, node_type()};
+    std::pair<iterator, bool> result =
+        body_.EmplaceUnique(node.key(), std::move(*node.value_));
+    if (!result.second) return {result.first, false, std::move(node)};
+    node.reset();
+    return {result.first, true, node_type()};
   }
 
+  iterator insert(iterator hint, node_type&& node) {
+    if (node.empty()) return end();
+    std::pair<iterator, bool> result =
+        body_.EmplaceHint(hint, node.key(), std::move(*node.value_));
+    if (result.second) node.reset();
+    return result.first;
+  }
+
+  // keeps iterators valid, except with ArenaTreeBackend (see ArenaTree)
+  void swap(map& other) noexcept { body_.swap(other.body_); }
+  void merge(map& other) { body_.merge(other.body_); }
+
+  /*
+  set algebra by key in place, the values kept are ours; with the
+  red-black backend it runs by split and join, in parallel for large maps
+  */
+  void unite(const map& other) { body_.unite(other.body_); }
+  void intersect(const map& other) { body_.intersect(other.body_); }
+  void subtract(const map& other) { body_.subtract(other.body_); }
+  bool contains(const Key& key) const noexcept { return body_.contains(key); }
+
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  bool contains(const K& key) const noexcept {
+    return body_.contains(key);
+  }
+
+  // order statistics, available with OrderStatisticTreeBackend
+  size_type rank(const Key& key) const noexcept { return body_.rank(key); }
+
+  iterator select(size_type k) const noexcept { return body_.select(k); }
+
  private:
-  class Comparator {
+  class KeyOfValue {
    public:
-    bool operator()(const_reference value1,
-                    const_reference value2) const noexcept {
-      return value1.first < value2.first;
+    const key_type& operator()(const_reference value) const noexcept {
+      return value.first;
     }
   };
 
-  tree_type* body_;
+  tree_type body_;
 };
 }  // namespace s21
 
@@ -0,0 +1,646 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_MEMORY_RESOURCE_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_MEMORY_RESOURCE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "s21_list.h"
+#include "s21_map.h"
+#include "s21_queue.h"
+#include "s21_set.h"
+#include "s21_stack.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+// snapshot of the counters kept by every s21 memory resource
+struct ResourceStats {
+  std::size_t bytes_in_use;
+  std::size_t peak_bytes;
+  std::size_t allocations;
+  std::size_t deallocations;
+};
+
+/*
+counters behind ResourceStats
+Counter is std::size_t for resources used by one thread at a time and
+std::atomic<std::size_t> for the ones shared between threads
+*/
+template <class Counter>
+class ResourceCounters {
+ public:
+  ResourceStats stats() const noexcept {
+    return {Load(bytes_in_use_), Load(peak_bytes_), Load(allocations_),
+            Load(deallocations_)};
+  }
+
+ protected:
+  void Record(std::ptrdiff_t bytes, std::size_t allocations,
+              std::size_t deallocations) noexcept {
+    std::size_t in_use = Add(bytes_in_use_, static_cast<std::size_t>(bytes));
+    Add(allocations_, allocations);
+    Add(deallocations_, deallocations);
+    if constexpr (std::is_same_v<Counter, std::size_t>) {
+      peak_bytes_ = std::max(peak_bytes_, in_use);
+    } else {
+      std::size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+      while (in_use > peak && !peak_bytes_.compare_exchange_weak(
+                                  peak, in_use, std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  void RecordAllocation(std::size_t bytes) noexcept {
+    Record(static_cast<std::ptrdiff_t>(bytes), 1, 0);
+  }
+
+  void RecordDeallocation(std::size_t bytes) noexcept {
+    Record(-static_cast<std::ptrdiff_t>(bytes), 0, 1);
+  }
+
+  // everything handed out is gone at once, e.g. after release()
+  void ResetBytesInUse() noexcept { bytes_in_use_ = 0; }
+
+ private:
+  // wraps around for negative deltas, which is what unsigned counters want
+  static std::size_t Add(Counter& counter, std::size_t delta) noexcept {
+    if constexpr (std::is_same_v<Counter, std::size_t>) {
+      return counter += delta;
+    } else {
+      return counter.fetch_add(delta, std::memory_order_relaxed) + delta;
+    }
+  }
+
+  static std::size_t Load(const Counter& counter) noexcept {
+    if constexpr (std::is_same_v<Counter, std::size_t>) {
+      return counter;
+    } else {
+      return counter.load(std::memory_order_relaxed);
+    }
+  }
+
+  Counter bytes_in_use_{};
+  Counter peak_bytes_{};
+  Counter allocations_{};
+  Counter deallocations_{};
+};
+
+/*
+forwards every request to upstream and only counts it
+wrap another resource in it to see what one container costs
+*/
+class CountingResource : public std::pmr::memory_resource,
+                         public ResourceCounters<std::size_t> {
+ public:
+  explicit CountingResource(
+      std::pmr::memory_resource* upstream =
+          std::pmr::get_default_resource()) noexcept
+      : upstream_(upstream) {}
+
+  CountingResource(const CountingResource& other) = delete;
+  CountingResource& operator=(const CountingResource& other) = delete;
+
+  std::pmr::memory_resource* upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void* memory = upstream_->allocate(bytes, alignment);
+    RecordAllocation(bytes);
+    return memory;
+  }
+
+  void do_deallocate(void* memory, std::size_t bytes,
+                     std::size_t alignment) override {
+    upstream_->deallocate(memory, bytes, alignment);
+    RecordDeallocation(bytes);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  std::pmr::memory_resource* upstream_;
+};
+
+/*
+bump allocator: memory is carved sequentially out of chunks which grow
+geometrically, deallocate only updates the counters and nothing is
+reused until release(), which gives all chunks back to upstream
+*/
+class MonotonicBufferResource : public std::pmr::memory_resource,
+                                public ResourceCounters<std::size_t> {
+ public:
+  static constexpr std::size_t kMinChunkBytes = 1024;
+
+  explicit MonotonicBufferResource(
+      std::pmr::memory_resource* upstream =
+          std::pmr::get_default_resource()) noexcept
+      : MonotonicBufferResource(kMinChunkBytes, upstream) {}
+
+  // the first chunk requested from upstream holds at least initial_size
+  explicit MonotonicBufferResource(
+      std::size_t initial_size, std::pmr::memory_resource* upstream =
+                                    std::pmr::get_default_resource()) noexcept
+      : upstream_(upstream),
+        chunks_(nullptr),
+        initial_buffer_(nullptr),
+        initial_size_(0),
+        current_(nullptr),
+        space_(0),
+        first_chunk_bytes_(std::max(initial_size, kMinChunkBytes)),
+        next_chunk_bytes_(first_chunk_bytes_) {}
+
+  // buffer is used first and never handed to upstream
+  MonotonicBufferResource(void* buffer, std::size_t size,
+                          std::pmr::memory_resource* upstream =
+                              std::pmr::get_default_resource()) noexcept
+      : upstream_(upstream),
+        chunks_(nullptr),
+        initial_buffer_(buffer),
+        initial_size_(size),
+        current_(buffer),
+        space_(size),
+        first_chunk_bytes_(std::max(size, kMinChunkBytes)),
+        next_chunk_bytes_(first_chunk_bytes_) {}
+
+  MonotonicBufferResource(const MonotonicBufferResource& other) = delete;
+  MonotonicBufferResource& operator=(const MonotonicBufferResource& other) =
+      delete;
+
+  ~MonotonicBufferResource() override { release(); }
+
+  void release() noexcept {
+    while (chunks_ != nullptr) {
+      Chunk* next = chunks_->next_;
+      upstream_->deallocate(chunks_, chunks_->bytes_, kChunkAlignment);
+      chunks_ = next;
+    }
+    current_ = initial_buffer_;
+    space_ = initial_size_;
+    next_chunk_bytes_ = first_chunk_bytes_;
+    ResetBytesInUse();
+  }
+
+  std::pmr::memory_resource* upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void* memory = current_;
+    if (std::align(alignment, bytes, memory, space_) == nullptr) {
+      AddChunk(bytes + alignment);
+      memory = current_;
+      std::align(alignment, bytes, memory, space_);
+    }
+    current_ = static_cast<unsigned char*>(memory) + bytes;
+    space_ -= bytes;
+    RecordAllocation(bytes);
+    return memory;
+  }
+
+  void do_deallocate(void*, std::size_t bytes, std::size_t) override {
+    RecordDeallocation(bytes);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  static constexpr std::size_t kChunkAlignment = alignof(std::max_align_t);
+
+  struct Chunk {
+    Chunk* next_;
+    std::size_t bytes_;
+  };
+
+  static constexpr std::size_t kChunkHeader =
+      (sizeof(Chunk) + kChunkAlignment - 1) / kChunkAlignment *
+      kChunkAlignment;
+
+  // what is left of the current chunk is abandoned
+  void AddChunk(std::size_t min_bytes) {
+    std::size_t bytes = std::max(next_chunk_bytes_, min_bytes + kChunkHeader);
+    Chunk* chunk =
+        static_cast<Chunk*>(upstream_->allocate(bytes, kChunkAlignment));
+    chunk->next_ = chunks_;
+    chunk->bytes_ = bytes;
+    chunks_ = chunk;
+    current_ = reinterpret_cast<unsigned char*>(chunk) + kChunkHeader;
+    space_ = bytes - kChunkHeader;
+    next_chunk_bytes_ = bytes * 2;
+  }
+
+  std::pmr::memory_resource* upstream_;
+  Chunk* chunks_;
+  void* initial_buffer_;
+  std::size_t initial_size_;
+  void* current_;
+  std::size_t space_;
+  std::size_t first_chunk_bytes_;
+  std::size_t next_chunk_bytes_;
+};
+
+/*
+size-class pool, not synchronized
+requests up to kMaxBlockBytes are rounded up to a power of two and served
+from per-class free lists, which are refilled from chunks that grow like
+NodePool slabs; bigger or over-aligned requests go straight to upstream
+*/
+class PoolResource : public std::pmr::memory_resource,
+                     public ResourceCounters<std::size_t> {
+ public:
+  static constexpr std::size_t kMinBlockBytes = sizeof(void*);
+  static constexpr std::size_t kMaxBlockBytes = 4096;
+  static constexpr std::size_t kClasses = [] {
+    std::size_t classes = 1;
+    while ((kMinBlockBytes << (classes - 1)) < kMaxBlockBytes) ++classes;
+    return classes;
+  }();
+  static constexpr std::size_t kMinChunkBlocks = 16;
+  static constexpr std::size_t kMaxChunkBlocks = 1024;
+
+  explicit PoolResource(std::pmr::memory_resource* upstream =
+                            std::pmr::get_default_resource()) noexcept
+      : upstream_(upstream), chunks_(nullptr), pools_() {}
+
+  PoolResource(const PoolResource& other) = delete;
+  PoolResource& operator=(const PoolResource& other) = delete;
+
+  ~PoolResource() override { release(); }
+
+  /*
+  gives all chunks back to upstream; blocks that went straight to upstream
+  are not tracked and stay with their owners
+  */
+  void release() noexcept {
+    while (chunks_ != nullptr) {
+      Chunk* next = chunks_->next_;
+      upstream_->deallocate(chunks_, chunks_->bytes_, kChunkAlignment);
+      chunks_ = next;
+    }
+    for (Pool& pool : pools_) pool = Pool{};
+    ResetBytesInUse();
+  }
+
+  std::pmr::memory_resource* upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+  // kClasses for requests served by upstream
+  static std::size_t SizeClass(std::size_t bytes,
+                               std::size_t alignment) noexcept {
+    std::size_t size = std::max(bytes, alignment);
+    if (size > kMaxBlockBytes || alignment > kChunkAlignment) return kClasses;
+    std::size_t index = 0;
+    while ((kMinBlockBytes << index) < size) ++index;
+    return index;
+  }
+
+  static constexpr std::size_t BlockBytes(std::size_t index) noexcept {
+    return kMinBlockBytes << index;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    std::size_t index = SizeClass(bytes, alignment);
+    void* memory = nullptr;
+    if (index == kClasses) {
+      memory = upstream_->allocate(bytes, alignment);
+    } else {
+      Pool& pool = pools_[index];
+      if (pool.free_ == nullptr) Refill(index);
+      memory = pool.free_;
+      pool.free_ = pool.free_->next_;
+    }
+    RecordAllocation(bytes);
+    return memory;
+  }
+
+  void do_deallocate(void* memory, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::size_t index = SizeClass(bytes, alignment);
+    if (index == kClasses) {
+      upstream_->deallocate(memory, bytes, alignment);
+    } else {
+      Block* block = static_cast<Block*>(memory);
+      block->next_ = pools_[index].free_;
+      pools_[index].free_ = block;
+    }
+    RecordDeallocation(bytes);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  static constexpr std::size_t kChunkAlignment = alignof(std::max_align_t);
+
+  struct Block {
+    Block* next_;
+  };
+
+  struct Chunk {
+    Chunk* next_;
+    std::size_t bytes_;
+  };
+
+  struct Pool {
+    Block* free_ = nullptr;
+    std::size_t next_blocks_ = kMinChunkBlocks;
+  };
+
+  static constexpr std::size_t kChunkHeader =
+      (sizeof(Chunk) + kChunkAlignment - 1) / kChunkAlignment *
+      kChunkAlignment;
+
+  // blocks of one class sit back to back, so each is aligned to its size
+  void Refill(std::size_t index) {
+    Pool& pool = pools_[index];
+    std::size_t block_bytes = BlockBytes(index);
+    std::size_t blocks = pool.next_blocks_;
+    std::size_t bytes = kChunkHeader + blocks * block_bytes;
+    Chunk* chunk =
+        static_cast<Chunk*>(upstream_->allocate(bytes, kChunkAlignment));
+    chunk->next_ = chunks_;
+    chunk->bytes_ = bytes;
+    chunks_ = chunk;
+    pool.next_blocks_ = std::min(blocks * 2, kMaxChunkBlocks);
+
+    unsigned char* first =
+        reinterpret_cast<unsigned char*>(chunk) + kChunkHeader;
+    for (std::size_t i = blocks; i > 0; --i) {
+      Block* block = reinterpret_cast<Block*>(first + (i - 1) * block_bytes);
+      block->next_ = pool.free_;
+      pool.free_ = block;
+    }
+  }
+
+  std::pmr::memory_resource* upstream_;
+  Chunk* chunks_;
+  Pool pools_[kClasses];
+};
+
+/*
+size-class pool shared between threads
+every thread keeps its own free lists and takes the mutex only to refill
+or drain them kBatchBlocks at a time; counters are folded in at the same
+moments (so peak_bytes is approximate), stats() folds in the calling
+thread first
+
+a thread caches blocks for up to kCacheSlots resources, the cache of a
+resource is handed back to it when the slot is reused or the thread
+exits; upstream has to be thread-safe
+*/
+class ThreadLocalPoolResource
+    : public std::pmr::memory_resource,
+      public ResourceCounters<std::atomic<std::size_t>> {
+ public:
+  static constexpr std::size_t kBatchBlocks = 32;
+  static constexpr std::size_t kMaxCachedBlocks = 2 * kBatchBlocks;
+  static constexpr std::size_t kCacheSlots = 4;
+
+  explicit ThreadLocalPoolResource(
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : id_(0), shared_(upstream) {
+    std::lock_guard<std::mutex> registry_lock(RegistryMutex());
+    Register();
+  }
+
+  ThreadLocalPoolResource(const ThreadLocalPoolResource& other) = delete;
+  ThreadLocalPoolResource& operator=(const ThreadLocalPoolResource& other) =
+      delete;
+
+  ~ThreadLocalPoolResource() override {
+    std::lock_guard<std::mutex> registry_lock(RegistryMutex());
+    Registry().erase(id_);
+  }
+
+  /*
+  must not run concurrently with allocations from this resource;
+  caches still holding released blocks refer to the old id and are dropped
+  */
+  void release() {
+    std::lock_guard<std::mutex> registry_lock(RegistryMutex());
+    Registry().erase(id_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shared_.release();
+      ResetBytesInUse();
+    }
+    Register();
+  }
+
+  std::pmr::memory_resource* upstream_resource() const noexcept {
+    return shared_.upstream_resource();
+  }
+
+  ResourceStats stats() noexcept {
+    Fold(LocalCache());
+    return ResourceCounters::stats();
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    std::size_t index = PoolResource::SizeClass(bytes, alignment);
+    Cache& cache = LocalCache();
+    void* memory = nullptr;
+    if (index == PoolResource::kClasses) {
+      memory = shared_.upstream_resource()->allocate(bytes, alignment);
+    } else {
+      FreeList& list = cache.lists_[index];
+      if (list.head_ == nullptr) Refill(cache, index);
+      memory = list.head_;
+      list.head_ = list.head_->next_;
+      --list.count_;
+    }
+    cache.bytes_ += static_cast<std::ptrdiff_t>(bytes);
+    ++cache.allocations_;
+    return memory;
+  }
+
+  void do_deallocate(void* memory, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::size_t index = PoolResource::SizeClass(bytes, alignment);
+    Cache& cache = LocalCache();
+    if (index == PoolResource::kClasses) {
+      shared_.upstream_resource()->deallocate(memory, bytes, alignment);
+    } else {
+      FreeList& list = cache.lists_[index];
+      Block* block = static_cast<Block*>(memory);
+      block->next_ = list.head_;
+      list.head_ = block;
+      if (++list.count_ > kMaxCachedBlocks) Drain(cache, index, kBatchBlocks);
+    }
+    cache.bytes_ -= static_cast<std::ptrdiff_t>(bytes);
+    ++cache.deallocations_;
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+ private:
+  struct Block {
+    Block* next_;
+  };
+
+  struct FreeList {
+    Block* head_;
+    std::size_t count_;
+  };
+
+  // owner_ == 0 marks a free slot
+  struct Cache {
+    std::uint64_t owner_;
+    FreeList lists_[PoolResource::kClasses];
+    std::ptrdiff_t bytes_;
+    std::size_t allocations_;
+    std::size_t deallocations_;
+  };
+
+  struct ThreadCaches {
+    ~ThreadCaches() {
+      for (Cache& cache : slots_) GiveBack(cache);
+    }
+
+    Cache slots_[kCacheSlots] = {};
+    std::size_t next_victim_ = 0;
+  };
+
+  // live resources by id, guarded by RegistryMutex()
+  static std::unordered_map<std::uint64_t, ThreadLocalPoolResource*>&
+  Registry() {
+    static std::unordered_map<std::uint64_t, ThreadLocalPoolResource*>
+        registry;
+    return registry;
+  }
+
+  static std::mutex& RegistryMutex() {
+    static std::mutex registry_mutex;
+    return registry_mutex;
+  }
+
+  // ids are never reused, so a stale cache cannot match a new resource
+  void Register() {
+    static std::uint64_t next_id = 1;
+    id_ = next_id++;
+    Registry().emplace(id_, this);
+  }
+
+  static void GiveBack(Cache& cache) noexcept {
+    if (cache.owner_ != 0) {
+      std::lock_guard<std::mutex> registry_lock(RegistryMutex());
+      auto owner = Registry().find(cache.owner_);
+      if (owner != Registry().end()) owner->second->Absorb(cache);
+    }
+    cache = Cache{};
+  }
+
+  Cache& LocalCache() noexcept {
+    thread_local ThreadCaches caches;
+    for (Cache& cache : caches.slots_) {
+      if (cache.owner_ == id_) return cache;
+    }
+    Cache& cache = caches.slots_[caches.next_victim_];
+    caches.next_victim_ = (caches.next_victim_ + 1) % kCacheSlots;
+    GiveBack(cache);
+    cache.owner_ = id_;
+    return cache;
+  }
+
+  void Fold(Cache& cache) noexcept {
+    Record(cache.bytes_, cache.allocations_, cache.deallocations_);
+    cache.bytes_ = 0;
+    cache.allocations_ = cache.deallocations_ = 0;
+  }
+
+  static std::size_t BlockAlignment(std::size_t block_bytes) noexcept {
+    return std::min(block_bytes, alignof(std::max_align_t));
+  }
+
+  void Refill(Cache& cache, std::size_t index) {
+    std::size_t block_bytes = PoolResource::BlockBytes(index);
+    FreeList& list = cache.lists_[index];
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < kBatchBlocks; ++i) {
+      Block* block = static_cast<Block*>(
+          shared_.allocate(block_bytes, BlockAlignment(block_bytes)));
+      block->next_ = list.head_;
+      list.head_ = block;
+      ++list.count_;
+    }
+    Fold(cache);
+  }
+
+  void Drain(Cache& cache, std::size_t index, std::size_t blocks) noexcept {
+    std::size_t block_bytes = PoolResource::BlockBytes(index);
+    FreeList& list = cache.lists_[index];
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (; blocks > 0; --blocks) {
+      Block* block = list.head_;
+      list.head_ = block->next_;
+      --list.count_;
+      shared_.deallocate(block, block_bytes, BlockAlignment(block_bytes));
+    }
+    Fold(cache);
+  }
+
+  // called with the registry locked, cache belongs to a finished slot
+  void Absorb(Cache& cache) noexcept {
+    for (std::size_t index = 0; index < PoolResource::kClasses; ++index) {
+      Drain(cache, index, cache.lists_[index].count_);
+    }
+  }
+
+  std::uint64_t id_;
+  std::mutex mutex_;
+  PoolResource shared_;
+};
+
+// the containers with their memory taken from a std::pmr::memory_resource
+namespace pmr {
+template <class T>
+using Vector = s21::Vector<T, std::pmr::polymorphic_allocator<T>>;
+
+template <class T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+
+template <class T>
+using Queue = s21::Queue<T, std::pmr::polymorphic_allocator<T>>;
+
+template <class T>
+using Stack = s21::Stack<T, std::pmr::polymorphic_allocator<T>>;
+
+template <class Key, class T, class Compare = std::less<Key>,
+          class Backend = RedBlackTreeBackend>
+using map = s21::map<Key, T, Compare,
+                     std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+                     Backend>;
+
+template <class Key, class Compare = std::less<Key>,
+          class Backend = RedBlackTreeBackend>
+using Set =
+    s21::Set<Key, Compare, std::pmr::polymorphic_allocator<Key>, Backend>;
+}  // namespace pmr
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_MEMORY_RESOURCE_H_
@@ -0,0 +1,115 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_NODE_HANDLE_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_NODE_HANDLE_H_
+
+#include <optional>
+#include <utility>
+
+namespace s21 {
+
+template <class Key, class Compare, class Allocator, class Backend>
+class Set;
+
+template <class Key, class T, class Compare, class Allocator, class Backend>
+class map;
+
+/*
+element taken out of a map or Set by extract()
+tree nodes belong to the pool (or leaf) of their tree and cannot leave it,
+so the handle holds the value itself: the element goes back to a container
+by a move, its node slot is the one the extract freed when it goes back to
+the same container; the key is mutable while the handle holds it
+*/
+template <class Value, class Allocator>
+class NodeHandleBase {
+ public:
+  using allocator_type = Allocator;
+
+  NodeHandleBase() noexcept = default;
+
+  NodeHandleBase(NodeHandleBase&& other) noexcept
+      : value_(std::move(other.value_)),
+        allocator_(std::move(other.allocator_)) {
+    other.reset();
+  }
+
+  NodeHandleBase& operator=(NodeHandleBase&& other) noexcept {
+    if (this != &other) {
+      value_ = std::move(other.value_);
+      allocator_ = std::move(other.allocator_);
+      other.reset();
+    }
+    return *this;
+  }
+
+  bool empty() const noexcept { return !value_.has_value(); }
+  explicit operator bool() const noexcept { return value_.has_value(); }
+
+  allocator_type get_allocator() const { return *allocator_; }
+
+  void swap(NodeHandleBase& other) noexcept {
+    value_.swap(other.value_);
+    allocator_.swap(other.allocator_);
+  }
+
+ protected:
+  NodeHandleBase(Value&& value, const allocator_type& alloc)
+      : value_(std::move(value)), allocator_(alloc) {}
+
+  void reset() noexcept {
+    value_.reset();
+    allocator_.reset();
+  }
+
+  std::optional<Value> value_;
+  std::optional<allocator_type> allocator_;
+};
+
+template <class Key, class Allocator>
+class SetNodeHandle : public NodeHandleBase<Key, Allocator> {
+ public:
+  using value_type = Key;
+
+  SetNodeHandle() noexcept = default;
+
+  value_type& value() noexcept { return *this->value_; }
+
+ private:
+  template <class, class, class, class>
+  friend class Set;
+
+  SetNodeHandle(Key&& value, const Allocator& alloc)
+      : NodeHandleBase<Key, Allocator>(std::move(value), alloc) {}
+};
+
+// the key is held unconst, a map node handle can rekey its element
+template <class Key, class T, class Allocator>
+class MapNodeHandle : public NodeHandleBase<std::pair<Key, T>, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+
+  MapNodeHandle() noexcept = default;
+
+  key_type& key() noexcept { return this->value_->first; }
+  mapped_type& mapped() noexcept { return this->value_->second; }
+
+ private:
+  template <class, class, class, class, class>
+  friend class map;
+
+  MapNodeHandle(std::pair<Key, T>&& value, const Allocator& alloc)
+      : NodeHandleBase<std::pair<Key, T>, Allocator>(std::move(value),
+                                                     alloc) {}
+};
+
+// result of inserting a node handle; node is the handle back on failure
+template <class Iterator, class NodeType>
+struct NodeInsertReturn {
+  Iterator position;
+  bool inserted;
+  NodeType node;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_NODE_HANDLE_H_
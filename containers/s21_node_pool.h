@@ -0,0 +1,268 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_NODE_POOL_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_NODE_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace s21 {
+
+/*
+pool of fixed-size nodes
+nodes are carved sequentially out of large slabs, freed nodes go to an
+intrusive free list and are reused before a new slab is requested;
+Reset makes every slot available again but keeps the slabs, in O(1);
+Release gives all memory back in O(number of slabs);
+slabs are requested from Allocator rebound to the slot type
+*/
+template <class Node, class Allocator = std::allocator<Node>>
+class NodePool {
+ private:
+  union Slot;
+  using slot_allocator_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator_type>;
+
+ public:
+  using node_type = Node;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  static constexpr size_type kMinSlabNodes = 16;
+  static constexpr size_type kMaxSlabNodes = size_type{1} << 16;
+
+  NodePool() noexcept(noexcept(allocator_type()))
+      : NodePool(allocator_type()) {}
+
+  explicit NodePool(const allocator_type& alloc) noexcept
+      : slabs_(nullptr),
+        free_(nullptr),
+        cursor_(nullptr),
+        slab_end_(nullptr),
+        reuse_(nullptr),
+        available_(size_type{}),
+        capacity_(size_type{}),
+        slot_allocator_(alloc) {}
+
+  NodePool(const NodePool& other) = delete;
+
+  NodePool(NodePool&& other) noexcept : NodePool(other.get_allocator()) {
+    SwapSlabs(other);
+  }
+
+  NodePool& operator=(const NodePool& other) = delete;
+
+  // takes the allocator of other along with its slabs
+  NodePool& operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+      Release();
+      slot_allocator_ = other.slot_allocator_;
+      SwapSlabs(other);
+    }
+    return *this;
+  }
+
+  ~NodePool() { Release(); }
+
+  // raw storage for one node, no constructor is called
+  node_type* Allocate() {
+    Slot* slot = free_;
+    if (slot != nullptr) {
+      free_ = slot->next_;
+    } else {
+      if (cursor_ == slab_end_) NextSlab();
+      slot = cursor_++;
+    }
+    --available_;
+    return reinterpret_cast<node_type*>(slot->storage_);
+  }
+
+  void Deallocate(node_type* node) noexcept {
+    if (node == nullptr) return;
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next_ = free_;
+    free_ = slot;
+    ++available_;
+  }
+
+  template <class... Args>
+  node_type* Create(Args&&... args) {
+    node_type* node = Allocate();
+    try {
+      ::new (static_cast<void*>(node)) node_type(std::forward<Args>(args)...);
+    } catch (...) {
+      Deallocate(node);
+      throw;
+    }
+    return node;
+  }
+
+  void Destroy(node_type* node) noexcept {
+    if (node != nullptr) {
+      node->~node_type();
+      Deallocate(node);
+    }
+  }
+
+  // guarantees n allocations without touching the global allocator
+  void Reserve(size_type n) {
+    if (n > available_) AddSlab(n - available_);
+  }
+
+  /*
+  every slot becomes free while the slabs are kept for the next nodes
+  live nodes must already be destroyed (or be trivially destructible),
+  every pointer into the pool becomes invalid
+  */
+  void Reset() noexcept {
+    free_ = cursor_ = slab_end_ = nullptr;
+    reuse_ = slabs_;
+    available_ = capacity_;
+  }
+
+  /*
+  frees whole slabs at once
+  live nodes must already be destroyed (or be trivially destructible),
+  every pointer into the pool becomes invalid
+  */
+  void Release() noexcept {
+    while (slabs_ != nullptr) {
+      Slot* next = slabs_->header_.next_slab_;
+      slot_traits::deallocate(slot_allocator_, slabs_,
+                              slabs_->header_.slots_);
+      slabs_ = next;
+    }
+    free_ = cursor_ = slab_end_ = reuse_ = nullptr;
+    available_ = capacity_ = size_type{};
+  }
+
+  /*
+  takes over all slabs of other together with the nodes living in them;
+  the allocators must compare equal
+  */
+  void Splice(NodePool& other) noexcept {
+    if (other.slabs_ == nullptr) return;
+    other.FreeUncarved();
+    Slot* last_slab = other.slabs_;
+    while (last_slab->header_.next_slab_ != nullptr) {
+      last_slab = last_slab->header_.next_slab_;
+    }
+    last_slab->header_.next_slab_ = slabs_;
+    slabs_ = other.slabs_;
+    if (other.free_ != nullptr) {
+      Slot* last_free = other.free_;
+      while (last_free->next_ != nullptr) last_free = last_free->next_;
+      last_free->next_ = free_;
+      free_ = other.free_;
+    }
+    available_ += other.available_;
+    capacity_ += other.capacity_;
+    other.slabs_ = other.free_ = other.cursor_ = other.slab_end_ = nullptr;
+    other.reuse_ = nullptr;
+    other.available_ = other.capacity_ = size_type{};
+  }
+
+  size_type capacity() const noexcept { return capacity_; }
+
+  size_type available() const noexcept { return available_; }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(slot_allocator_);
+  }
+
+  /*
+  allocators that propagate on swap or move are exchanged together with the
+  slabs; any other pair of pools may swap only if their allocators are equal
+  */
+  void swap(NodePool& other) noexcept {
+    SwapSlabs(other);
+    if constexpr (slot_traits::propagate_on_container_swap::value ||
+                  slot_traits::propagate_on_container_move_assignment::value) {
+      std::swap(slot_allocator_, other.slot_allocator_);
+    }
+  }
+
+ private:
+  struct SlabHeader {
+    Slot* next_slab_;
+    size_type slots_;
+  };
+
+  union Slot {
+    Slot* next_;
+    SlabHeader header_;
+    alignas(node_type) unsigned char storage_[sizeof(node_type)];
+  };
+
+  void SwapSlabs(NodePool& other) noexcept {
+    std::swap(slabs_, other.slabs_);
+    std::swap(free_, other.free_);
+    std::swap(cursor_, other.cursor_);
+    std::swap(slab_end_, other.slab_end_);
+    std::swap(reuse_, other.reuse_);
+    std::swap(available_, other.available_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  size_type NextSlabSize() const noexcept {
+    return std::min(std::max(capacity_, kMinSlabNodes), kMaxSlabNodes);
+  }
+
+  // the first slot of every slab holds its header
+  void AddSlab(size_type nodes) {
+    Slot* slab = slot_traits::allocate(slot_allocator_, nodes + 1);
+    slab->header_.next_slab_ = slabs_;
+    slab->header_.slots_ = nodes + 1;
+    slabs_ = slab;
+
+    // the unused tail of the previous slab goes to the free list
+    FreeSlots(cursor_, slab_end_);
+    cursor_ = slab + 1;
+    slab_end_ = cursor_ + nodes;
+    available_ += nodes;
+    capacity_ += nodes;
+  }
+
+  // carves the next slab kept by Reset, or a new one
+  void NextSlab() {
+    if (reuse_ == nullptr) {
+      AddSlab(NextSlabSize());
+    } else {
+      cursor_ = reuse_ + 1;
+      slab_end_ = reuse_ + reuse_->header_.slots_;
+      reuse_ = reuse_->header_.next_slab_;
+    }
+  }
+
+  // the rest of the current slab and the slabs kept by Reset
+  void FreeUncarved() noexcept {
+    FreeSlots(cursor_, slab_end_);
+    cursor_ = slab_end_ = nullptr;
+    for (; reuse_ != nullptr; reuse_ = reuse_->header_.next_slab_) {
+      FreeSlots(reuse_ + 1, reuse_ + reuse_->header_.slots_);
+    }
+  }
+
+  void FreeSlots(Slot* first, Slot* last) noexcept {
+    for (; first != last; ++first) {
+      first->next_ = free_;
+      free_ = first;
+    }
+  }
+
+  Slot* slabs_;
+  Slot* free_;
+  Slot* cursor_;
+  Slot* slab_end_;
+  // slabs after the current one that Reset left to carve again
+  Slot* reuse_;
+  size_type available_;
+  size_type capacity_;
+  [[no_unique_address]] slot_allocator_type slot_allocator_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_NODE_POOL_H_
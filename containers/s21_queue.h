@@ -2,40 +2,82 @@
 #define CPP2_S21_CONTAINERS_CONTAINERS_S21_QUEUE_H_
 
 #include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 namespace s21 {
-template <class T>
+// nodes are allocated from Allocator rebound to the node type
+template <class T, class Allocator = std::allocator<T>>
 class Queue {
+ private:
+  struct node;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using node_allocator_type =
+      typename alloc_traits::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
+
  public:
   using value_type = T;
   using reference = T&;
   using const_reference = const T&;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
-  Queue() noexcept : root_(nullptr), end_(nullptr) { queue_size_ = 0; }
-  Queue(std::initializer_list<value_type> const& list) noexcept : Queue() {
+  Queue() noexcept(noexcept(allocator_type())) : Queue(allocator_type()) {}
+  explicit Queue(const allocator_type& alloc) noexcept
+      : root_(nullptr), end_(nullptr), queue_size_(0), node_alloc_(alloc) {}
+  Queue(std::initializer_list<value_type> const& list,
+        const allocator_type& alloc = allocator_type())
+      : Queue(alloc) {
     for (const auto& i : list) {
       push(i);
     }
   }
-  Queue(const Queue& other) noexcept : Queue() { this->CopyQueue(other); }
-  Queue(Queue&& other) noexcept { this->MoveQueue((Queue &&) other); }
-
-  Queue& operator=(const Queue& other) noexcept {
+  Queue(const Queue& other)
+      : Queue(alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())) {
     this->CopyQueue(other);
-    return *this;
   }
-  Queue& operator=(Queue&& other) noexcept {
-    this->MoveQueue((Queue &&) other);
+  Queue(Queue&& other) noexcept : Queue(other.get_allocator()) {
+    this->MoveQueue(std::move(other));
+  }
+
+  Queue& operator=(const Queue& other) {
+    if (this != &other) {
+      Clear();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        node_alloc_ = other.node_alloc_;
+      }
+      this->CopyQueue(other);
+    }
     return *this;
   }
-  ~Queue() noexcept {
-    while (root_) {
-      node* elem = root_->next_;
-      delete root_;
-      root_ = elem;
+  // values are moved one by one only if the nodes of other cannot be stolen
+  Queue& operator=(Queue&& other) {
+    if (this != &other) {
+      Clear();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        node_alloc_ = other.node_alloc_;
+      } else if (node_alloc_ != other.node_alloc_) {
+        for (node* elem = other.root_; elem; elem = elem->next_) {
+          Append(CreateNode(std::move(elem->value_)));
+        }
+        other.Clear();
+        return *this;
+      }
+      this->MoveQueue(std::move(other));
     }
+    return *this;
+  }
+  ~Queue() noexcept { Clear(); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(node_alloc_);
   }
 
   const_reference front() const {
@@ -52,22 +94,12 @@ class Queue {
   }
   bool empty() const noexcept { return queue_size_ == 0; }
   size_type size() const noexcept { return queue_size_; }
-  void push(const_reference element) noexcept {
-    node* new_queue = new node{element, nullptr};
-    if (empty()) {
-      root_ = new_queue;
-      end_ = new_queue;
-    } else {
-      end_->next_ = new_queue;
-      end_ = new_queue;
-    }
-    queue_size_++;
-  }
+  void push(const_reference element) { Append(CreateNode(element)); }
   void pop() noexcept {
     if (!empty()) {
       node* elem = root_;
       root_ = root_->next_;
-      delete elem;
+      DestroyNode(elem);
       if (root_ == nullptr) {
         end_ = nullptr;
       }
@@ -84,6 +116,9 @@ class Queue {
     other.root_ = root_elem;
     other.end_ = end_elem;
     other.queue_size_ = size_e;
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(node_alloc_, other.node_alloc_);
+    }
   }
   void CopyQueue(const Queue& other) {
     node* elem = other.root_;
@@ -107,9 +142,48 @@ class Queue {
     node* next_;
   };
 
+  template <class V>
+  node* CreateNode(V&& value) {
+    node* elem = node_traits::allocate(node_alloc_, 1);
+    try {
+      ::new (static_cast<void*>(elem)) node{std::forward<V>(value), nullptr};
+    } catch (...) {
+      node_traits::deallocate(node_alloc_, elem, 1);
+      throw;
+    }
+    return elem;
+  }
+
+  void DestroyNode(node* elem) noexcept {
+    elem->~node();
+    node_traits::deallocate(node_alloc_, elem, 1);
+  }
+
+  void Append(node* new_queue) noexcept {
+    if (empty()) {
+      root_ = new_queue;
+      end_ = new_queue;
+    } else {
+      end_->next_ = new_queue;
+      end_ = new_queue;
+    }
+    queue_size_++;
+  }
+
+  void Clear() noexcept {
+    while (root_) {
+      node* elem = root_->next_;
+      DestroyNode(root_);
+      root_ = elem;
+    }
+    end_ = nullptr;
+    queue_size_ = 0;
+  }
+
   node* root_;
   node* end_;
   size_type queue_size_;
+  [[no_unique_address]] node_allocator_type node_alloc_;
 };
 }  // namespace s21
 
@@ -1,13 +1,21 @@
 #ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_SET_H_
 #define CPP2_S21_CONTAINERS_CONTAINERS_S21_SET_H_
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "../containers/s21_btree.h"
+#include "../containers/s21_node_handle.h"
 
 namespace s21 {
 
-template <class Key>
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>,
+          class Backend = RedBlackTreeBackend>
 class Set {
  public:
   using key_type = Key;
@@ -15,71 +23,226 @@ class Set {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
-  using rbtree_type = RedBlackTree<value_type>;
-  using iterator = typename rbtree_type::iterator;
-  using const_iterator = typename rbtree_type::const_iterator;
-
-  Set() { rbtree_ = new rbtree_type; };
-
-  Set(std::initializer_list<value_type> const &list) noexcept : Set() {
-    for (const auto i : list) {
+  using allocator_type = Allocator;
+  using key_compare = Compare;
+  using tree_type = typename Backend::template tree_type<
+      key_type, value_type, IdentityKey, key_compare, allocator_type>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using node_type = SetNodeHandle<key_type, allocator_type>;
+  using insert_return_type = NodeInsertReturn<iterator, node_type>;
+
+  Set() : tree_() {}
+
+  explicit Set(const allocator_type &alloc) : tree_(alloc) {}
+
+  explicit Set(const key_compare &comp,
+               const allocator_type &alloc = allocator_type())
+      : tree_(comp, alloc) {}
+
+  Set(std::initializer_list<value_type> const &list,
+      const key_compare &comp = key_compare(),
+      const allocator_type &alloc = allocator_type())
+      : Set(comp, alloc) {
+    for (const auto &i : list) {
       insert(i);
     }
   }
 
-  Set(const Set &other) { rbtree_ = new rbtree_type(*other.rbtree_); }
+  Set(std::initializer_list<value_type> const &list,
+      const allocator_type &alloc)
+      : Set(list, key_compare(), alloc) {}
 
-  Set(Set &&other) noexcept {
-    rbtree_ = new rbtree_type(std::move(*other.rbtree_));
+  template <class InputIt>
+  Set(InputIt first, InputIt last, const key_compare &comp = key_compare(),
+      const allocator_type &alloc = allocator_type())
+      : Set(comp, alloc) {
+    assign(first, last);
   }
 
+  template <class ForwardIt>
+  Set(sorted_unique_t, ForwardIt first, ForwardIt last,
+      const key_compare &comp = key_compare(),
+      const allocator_type &alloc = allocator_type())
+      : Set(comp, alloc) {
+    tree_.BuildSorted(first, last);
+  }
+
+  Set(const Set &other) : tree_(other.tree_) {}
+
+  Set(Set &&other) : tree_(std::move(other.tree_)) {}
+
   Set &operator=(const Set &other) {
-    rbtree_ = new rbtree_type(*other.rbtree_);
+    tree_ = other.tree_;
     return *this;
   }
 
-  Set &operator=(Set &&other) noexcept {
-    rbtree_ = new rbtree_type(std::move(*other.rbtree_));
+  Set &operator=(Set &&other) {
+    tree_ = std::move(other.tree_);
     return *this;
   }
 
-  ~Set() {
-    delete rbtree_;
-    rbtree_ = nullptr;
+  ~Set() = default;
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  }
+
+  /*
+  replaces the contents in O(n log n): a copy of the range is sorted and
+  the tree is built from it in O(n); of equivalent keys the first is kept
+  */
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    std::vector<value_type, allocator_type> keys(first, last,
+                                                 get_allocator());
+    auto is_less = tree_.key_comp();
+    std::stable_sort(keys.begin(), keys.end(), is_less);
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [&is_less](const value_type &left,
+                                      const value_type &right) {
+                             return !is_less(left, right);
+                           }),
+               keys.end());
+    tree_.BuildSorted(std::make_move_iterator(keys.begin()),
+                      std::make_move_iterator(keys.end()));
+  }
+
+  // [first, last) is already sorted and unique, O(n)
+  template <class ForwardIt>
+  void assign(sorted_unique_t, ForwardIt first, ForwardIt last) {
+    tree_.BuildSorted(first, last);
   }
 
-  bool empty() const noexcept { return rbtree_->empty(); };
+  bool empty() const noexcept { return tree_.empty(); };
 
-  size_type size() const noexcept { return rbtree_->size(); };
+  size_type size() const noexcept { return tree_.size(); };
 
-  size_type max_size() const noexcept { return rbtree_->max_size(); };
+  size_type max_size() const noexcept { return tree_.max_size(); };
 
   std::pair<iterator, bool> insert(const value_type &val) {
-    return rbtree_->insert(val);
+    return tree_.insert(val);
+  }
+
+  /*
+  hint is the position the value should go before; when it is right
+  (end() for increasing keys) no descent from the root is made
+  */
+  iterator insert(iterator hint, const value_type &val) {
+    return tree_.EmplaceHint(hint, val, val).first;
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return tree_.EmplaceHint(hint, value, std::move(value)).first;
   }
 
-  iterator find(const key_type &key) noexcept { return rbtree_->find(key); }
+  iterator find(const key_type &key) noexcept { return tree_.find(key); }
+
+  iterator lower_bound(const key_type &key) noexcept {
+    return tree_.lower_bound(key);
+  }
+
+  iterator upper_bound(const key_type &key) noexcept {
+    return tree_.upper_bound(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type &key) noexcept {
+    return tree_.equal_range(key);
+  }
+
+  // the keys in [low, high), walked lazily; empty unless low < high
+  IteratorRange<iterator> range(const key_type &low,
+                                const key_type &high) noexcept {
+    iterator first = tree_.lower_bound(low);
+    if (!tree_.key_comp()(low, high)) return {first, first};
+    return {first, tree_.lower_bound(high)};
+  }
 
   bool contains(const key_type &key) const noexcept {
-    bool flag = rbtree_->find(key) != rbtree_->end();
+    bool flag = tree_.find(key) != tree_.end();
     return flag;
   }
 
-  void erase(iterator iter) noexcept { rbtree_->erase(iter); }
+  void erase(iterator iter) noexcept { tree_.erase(iter); }
+
+  /*
+  node handles move an element between sets (or out and back in under a
+  new key) without copying it; an empty handle is returned for a missing
+  key
+  */
+  node_type extract(iterator pos) {
+    return node_type(tree_.template Extract<value_type>(pos),
+                     get_allocator());
+  }
+
+  node_type extract(const key_type &key) {
+    iterator pos = tree_.find(key);
+    if (pos == tree_.end()) return node_type();
+    return extract(pos);
+  }
 
-  void clear() { rbtree_->clear(); }
+  insert_return_type insert(node_type &&node) {
+    if (node.empty()) return {end(), false, node_type()};
+    std::pair<iterator, bool> result =
+        tree_.EmplaceUnique(*node.value_, std::move(*node.value_));
+    if (!result.second) return {result.first, false, std::move(node)};
+    node.reset();
+    return {result.first, true, node_type()};
+  }
 
-  void swap(Set &other) noexcept { rbtree_->swap(*other.rbtree_); }
+  iterator insert(iterator hint, node_type &&node) {
+    if (node.empty()) return end();
+    std::pair<iterator, bool> result =
+        tree_.EmplaceHint(hint, *node.value_, std::move(*node.value_));
+    if (result.second) node.reset();
+    return result.first;
+  }
 
-  void merge(Set &other) { rbtree_->merge(*other.rbtree_); };
+  // order statistics, available with OrderStatisticTreeBackend
+  size_type rank(const key_type &key) const noexcept {
+    return tree_.rank(key);
+  }
 
-  iterator begin() noexcept { return rbtree_->begin(); };
-  iterator end() noexcept { return rbtree_->end(); };
-  const_iterator cbegin() const noexcept { return rbtree_->begin(); };
-  const_iterator cend() const noexcept { return rbtree_->end(); };
+  iterator select(size_type k) const noexcept { return tree_.select(k); }
+
+  void clear() { tree_.clear(); }
+
+  void reserve(size_type n) { tree_.reserve(n); }
+
+  // keeps iterators valid, except with ArenaTreeBackend (see ArenaTree)
+  void swap(Set &other) noexcept { tree_.swap(other.tree_); }
+
+  void merge(Set &other) { tree_.merge(other.tree_); };
+
+  /*
+  set algebra in place; with the red-black backend it runs by split and
+  join, in parallel for large sets
+  */
+  void unite(const Set &other) { tree_.unite(other.tree_); }
+  void intersect(const Set &other) { tree_.intersect(other.tree_); }
+  void subtract(const Set &other) { tree_.subtract(other.tree_); }
+
+  iterator begin() noexcept { return tree_.begin(); };
+  iterator end() noexcept { return tree_.end(); };
+  const_iterator cbegin() const noexcept { return tree_.begin(); };
+  const_iterator cend() const noexcept { return tree_.end(); };
+
+  // backwards from the cached maximum
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(cend());
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(cbegin());
+  }
 
  private:
-  rbtree_type *rbtree_;
+  tree_type tree_;
 };
 
 };  // namespace s21
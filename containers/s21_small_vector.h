@@ -0,0 +1,504 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_SMALL_VECTOR_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../containers/s21_vector.h"
+
+namespace s21 {
+
+/*
+vector with the same interface as s21::Vector that keeps its first N
+elements inside the object and only goes to the heap past that
+moving or swapping a SmallVector whose elements are inline moves the
+elements one by one, so it is O(size) rather than O(1)
+*/
+template <class T, std::size_t N>
+class SmallVector : private VectorInsertion<SmallVector<T, N>, T> {
+ public:
+  // types
+  using value_type = T;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type kInlineCapacity = N;
+
+ private:
+  using Insertion = VectorInsertion<SmallVector, T>;
+  friend Insertion;
+  using Insertion::CanReadOwnElements;
+  using Insertion::ConstructEach;
+  using Insertion::InsertBuilt;
+
+  template <class It>
+  using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+      typename std::iterator_traits<It>::iterator_category,
+      std::input_iterator_tag>>;
+
+ public:
+  // constructors and destructors
+  SmallVector() noexcept : arr_(InlineData()), size_(0U), capacity_(N) {}
+
+  explicit SmallVector(size_type n) : SmallVector() { resize(n); }
+
+  explicit SmallVector(size_type n, const_reference value) : SmallVector() {
+    insert(cend(), n, value);
+  }
+
+  SmallVector(std::initializer_list<value_type> const &items)
+      : SmallVector() {
+    insert(cend(), items.begin(), items.end());
+  }
+
+  SmallVector(const SmallVector &other) : SmallVector() {
+    insert(cend(), other.cbegin(), other.cend());
+  }
+
+  SmallVector(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>)
+      : SmallVector() {
+    TakeElements(other);
+  }
+
+  ~SmallVector() {
+    std::destroy_n(arr_, size_);
+    FreeHeap();
+  }
+
+  // accessors and mutators
+
+  reference at(size_type index) {
+    if (index >= size_) {
+      throw std::out_of_range("index out of range");
+    }
+    return arr_[index];
+  }
+  const_reference at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("index out of range");
+    }
+    return arr_[index];
+  }
+  reference operator[](size_type pos) noexcept { return arr_[pos]; }
+  const_reference operator[](size_type pos) const noexcept { return arr_[pos]; }
+  reference front() noexcept { return arr_[0]; }
+  const_reference front() const noexcept { return arr_[0]; }
+  reference back() noexcept { return arr_[size_ - 1]; }
+  const_reference back() const noexcept { return arr_[size_ - 1]; }
+  pointer data() noexcept { return arr_; }
+  const_pointer data() const noexcept { return arr_; }
+
+  bool empty() const noexcept { return size_ == 0U; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+  void reserve(size_type new_capacity) {
+    if (new_capacity <= capacity_) return;
+    if (new_capacity > max_size()) {
+      throw std::length_error("value exceeds maximum size");
+    }
+    MoveTo(new_capacity);
+  }
+  size_type capacity() const noexcept { return capacity_; }
+  bool is_inline() const noexcept { return arr_ == InlineData(); }
+  void shrink_to_fit() {
+    if (is_inline() || size_ == capacity_) return;
+    MoveTo(size_ <= N ? N : size_);
+  }
+
+  void clear() noexcept {
+    std::destroy_n(arr_, size_);
+    size_ = 0U;
+  }
+
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
+    size_type index = pos - cbegin();
+    if (count == 0U) return begin() + index;
+    if (CanReadOwnElements(index, count)) {
+      InsertBuilt(index, count, [&](pointer dest) {
+        std::uninitialized_fill_n(dest, count, value);
+      });
+    } else {
+      // value may refer to an element that is about to be shifted
+      value_type tmp(value);
+      InsertBuilt(index, count, [&](pointer dest) {
+        std::uninitialized_fill_n(dest, count, tmp);
+      });
+    }
+    return begin() + index;
+  }
+
+  // the range must not point into this vector
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    size_type index = pos - cbegin();
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_type count = std::distance(first, last);
+      if (count != 0U) {
+        InsertBuilt(index, count, [&](pointer dest) {
+          std::uninitialized_copy(first, last, dest);
+        });
+      }
+    } else {
+      // single pass ranges are collected first to learn their length
+      SmallVector buffer;
+      for (; first != last; ++first) buffer.emplace_back(*first);
+      insert(pos, std::make_move_iterator(buffer.begin()),
+             std::make_move_iterator(buffer.end()));
+    }
+    return begin() + index;
+  }
+
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = pos - cbegin();
+    if (CanReadOwnElements(index, 1U)) {
+      InsertBuilt(index, 1U, [&](pointer dest) {
+        ::new (static_cast<void *>(dest))
+            value_type(std::forward<Args>(args)...);
+      });
+    } else {
+      // args may refer to an element that is about to be shifted
+      value_type tmp(std::forward<Args>(args)...);
+      InsertBuilt(index, 1U, [&](pointer dest) {
+        ::new (static_cast<void *>(dest)) value_type(std::move(tmp));
+      });
+    }
+    return begin() + index;
+  }
+
+  // every argument becomes one element, the tail is shifted once
+  template <class... Args>
+  iterator insert_many(const_iterator pos, Args &&...args) {
+    constexpr size_type count = sizeof...(Args);
+    size_type index = pos - cbegin();
+    if constexpr (count == 0U) {
+      return begin() + index;
+    } else {
+      if (CanReadOwnElements(index, count)) {
+        InsertBuilt(index, count, [&](pointer dest) {
+          ConstructEach(dest, std::forward<Args>(args)...);
+        });
+      } else {
+        // same as in emplace: build the values before the tail moves
+        alignas(value_type) unsigned char buffer[count * sizeof(value_type)];
+        pointer tmp = reinterpret_cast<pointer>(buffer);
+        ConstructEach(tmp, std::forward<Args>(args)...);
+        try {
+          InsertBuilt(index, count, [&](pointer dest) {
+            Relocate(tmp, count, dest);
+          });
+        } catch (...) {
+          std::destroy_n(tmp, count);
+          throw;
+        }
+        std::destroy_n(tmp, count);
+      }
+      return begin() + index + count - 1U;
+    }
+  }
+
+  template <class... Args>
+  void insert_many_back(Args &&...args) {
+    insert_many(cend(), std::forward<Args>(args)...);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = first - cbegin();
+    size_type count = last - first;
+    if (count != 0U) {
+      iterator dest = begin() + index;
+      std::move(dest + count, end(), dest);
+      std::destroy(end() - count, end());
+      size_ -= count;
+    }
+    return begin() + index;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      emplace(cend(), std::forward<Args>(args)...);
+    } else {
+      ::new (static_cast<void *>(end()))
+          value_type(std::forward<Args>(args)...);
+      ++size_;
+    }
+    return back();
+  }
+
+  void pop_back() noexcept {
+    --size_;
+    arr_[size_].~value_type();
+  }
+
+  void resize(const size_type count) {
+    if (count <= size_) {
+      std::destroy(begin() + count, end());
+    } else {
+      if (capacity_ < count) MoveTo(GrowthCapacity(count));
+      std::uninitialized_value_construct(end(), begin() + count);
+    }
+    size_ = count;
+  }
+
+  void resize(const size_type count, const_reference value) {
+    if (count <= size_) {
+      std::destroy(begin() + count, end());
+      size_ = count;
+    } else {
+      insert(cend(), count - size_, value);
+    }
+  }
+
+  friend void swap(SmallVector &lhs, SmallVector &rhs) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>) {
+    if (&lhs == &rhs) return;
+    if (!lhs.is_inline() && !rhs.is_inline()) {
+      std::swap(lhs.arr_, rhs.arr_);
+      std::swap(lhs.size_, rhs.size_);
+      std::swap(lhs.capacity_, rhs.capacity_);
+    } else {
+      SmallVector tmp(std::move(lhs));
+      lhs.TakeElements(rhs);
+      rhs.TakeElements(tmp);
+    }
+  }
+
+  // iterators
+  iterator begin() noexcept { return iterator(arr_); }
+  iterator end() noexcept { return iterator(arr_ + size_); }
+  const_iterator cbegin() const noexcept { return const_iterator(arr_); }
+  const_iterator cend() const noexcept { return const_iterator(arr_ + size_); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(arr_ + size_); }
+  reverse_iterator rend() noexcept { return reverse_iterator(arr_); }
+  const_reverse_iterator crbegin() const noexcept {
+    return const_reverse_iterator(arr_ + size_);
+  }
+  const_reverse_iterator crend() const noexcept {
+    return const_reverse_iterator(arr_);
+  }
+
+  // operators
+  bool operator==(const SmallVector &rhs) const {
+    return size_ == rhs.size_ && std::equal(cbegin(), cend(), rhs.cbegin());
+  }
+
+  bool operator!=(const SmallVector &rhs) const { return !(*this == rhs); }
+
+  bool operator<(const SmallVector &rhs) const {
+    return std::lexicographical_compare(cbegin(), cend(), rhs.cbegin(),
+                                        rhs.cend());
+  }
+
+  bool operator<=(const SmallVector &rhs) const { return !(rhs < *this); }
+
+  bool operator>(const SmallVector &rhs) const { return rhs < *this; }
+
+  bool operator>=(const SmallVector &rhs) const { return !(*this < rhs); }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      if (capacity_ < other.size_) {
+        clear();
+        MoveTo(other.size_);
+        std::uninitialized_copy(other.cbegin(), other.cend(), arr_);
+      } else if (size_ < other.size_) {
+        std::copy(other.cbegin(), other.cbegin() + size_, begin());
+        std::uninitialized_copy(other.cbegin() + size_, other.cend(), end());
+      } else {
+        std::copy(other.cbegin(), other.cend(), begin());
+        std::destroy(begin() + other.size_, end());
+      }
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>) {
+    if (this != &other) {
+      clear();
+      FreeHeap();
+      arr_ = InlineData();
+      capacity_ = N;
+      TakeElements(other);
+    }
+    return *this;
+  }
+
+ private:
+  pointer InlineData() noexcept {
+    return std::launder(reinterpret_cast<pointer>(inline_));
+  }
+
+  const_pointer InlineData() const noexcept {
+    return std::launder(reinterpret_cast<const_pointer>(inline_));
+  }
+
+  void FreeHeap() noexcept {
+    if (!is_inline()) std::allocator<value_type>().deallocate(arr_, capacity_);
+  }
+
+  /*
+  moves the contents of other into this empty inline vector: a heap
+  buffer is stolen, inline elements are moved one by one; other is left
+  empty and inline
+  */
+  void TakeElements(SmallVector &other) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>) {
+    if (other.is_inline()) {
+      std::uninitialized_move_n(other.arr_, other.size_, arr_);
+      size_ = other.size_;
+      other.clear();
+    } else {
+      arr_ = other.arr_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.arr_ = other.InlineData();
+      other.size_ = 0U;
+      other.capacity_ = N;
+    }
+  }
+
+  /*
+  capacity after a growth that must fit at least min_capacity elements:
+  the size is doubled, or grown straight to min_capacity if that is more
+  */
+  size_type GrowthCapacity(size_type min_capacity) const {
+    if (min_capacity > max_size()) {
+      throw std::length_error("value exceeds maximum size");
+    }
+    size_type doubled = size_ > max_size() - size_ ? max_size() : size_ * 2U;
+    return std::max(doubled, min_capacity);
+  }
+
+  // moves (or copies, if moving may throw) n elements into raw memory
+  static void Relocate(pointer first, size_type n, pointer dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                  !std::is_copy_constructible_v<value_type>) {
+      std::uninitialized_move_n(first, n, dest);
+    } else {
+      std::uninitialized_copy_n(first, n, dest);
+    }
+  }
+
+  /*
+  moves the elements into a buffer of new_capacity, leaving a gap of
+  gap_size elements at index that build(dest) constructs; a capacity of
+  at most N means the inline buffer, which must then not be in use
+  */
+  template <class Build>
+  void MoveTo(size_type new_capacity, size_type index, size_type gap_size,
+              Build build) {
+    bool to_inline = new_capacity <= N;
+    pointer new_arr =
+        to_inline ? InlineData()
+                  : std::allocator<value_type>().allocate(new_capacity);
+    try {
+      build(new_arr + index);
+      try {
+        Relocate(arr_, index, new_arr);
+        try {
+          Relocate(arr_ + index, size_ - index, new_arr + index + gap_size);
+        } catch (...) {
+          std::destroy_n(new_arr, index);
+          throw;
+        }
+      } catch (...) {
+        std::destroy_n(new_arr + index, gap_size);
+        throw;
+      }
+    } catch (...) {
+      if (!to_inline) {
+        std::allocator<value_type>().deallocate(new_arr, new_capacity);
+      }
+      throw;
+    }
+    std::destroy_n(arr_, size_);
+    FreeHeap();
+    arr_ = new_arr;
+    capacity_ = to_inline ? N : new_capacity;
+  }
+
+  void MoveTo(size_type new_capacity) {
+    MoveTo(new_capacity, size_, 0U, [](pointer) {});
+  }
+
+  template <class... Args>
+  static void Construct(pointer p, Args &&...args) {
+    ::new (static_cast<void *>(p)) value_type(std::forward<Args>(args)...);
+  }
+
+  static void Destroy(pointer first, size_type n) noexcept {
+    std::destroy_n(first, n);
+  }
+
+  // called by InsertBuilt, see VectorInsertion
+  bool ReallocationKeepsElements(size_type) const noexcept { return true; }
+
+  /*
+  the elements are built in the new heap buffer before the old one is
+  released; a fresh buffer is never inline, as the old one may be
+  */
+  template <class Build>
+  void InsertReallocating(size_type index, size_type count, bool grow,
+                          Build build) {
+    size_type new_capacity =
+        std::max(grow ? GrowthCapacity(size_ + count) : capacity_, N + 1U);
+    MoveTo(new_capacity, index, count, build);
+  }
+
+  value_type *arr_;
+  size_type size_;
+  size_type capacity_;
+  alignas(value_type) unsigned char inline_[(N ? N : 1U) * sizeof(value_type)];
+};
+
+// removes every element matching pred in one pass, returns their number
+template <class T, std::size_t N, class Pred>
+typename SmallVector<T, N>::size_type erase_if(SmallVector<T, N> &vec,
+                                               Pred pred) {
+  auto last = std::remove_if(vec.begin(), vec.end(), pred);
+  typename SmallVector<T, N>::size_type count = vec.end() - last;
+  vec.erase(last, vec.end());
+  return count;
+}
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_SMALL_VECTOR_H_
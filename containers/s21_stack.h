@@ -2,63 +2,94 @@
 #define CPP2_S21_CONTAINERS_CONTAINERS_S21_STACK_H_
 
 #include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 namespace s21 {
 
-template <class T>
+// nodes are allocated from Allocator rebound to the node type
+template <class T, class Allocator = std::allocator<T>>
 class Stack {
+ private:
+  struct node;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using node_allocator_type =
+      typename alloc_traits::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
+
  public:
   using value_type = T;
   using reference = T&;
   using const_reference = const T&;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
-  Stack() noexcept {
-    stack_size_ = 0;
-    root_ = nullptr;
-  }
-  Stack(std::initializer_list<value_type> const& list) noexcept : Stack() {
+  Stack() noexcept(noexcept(allocator_type())) : Stack(allocator_type()) {}
+  explicit Stack(const allocator_type& alloc) noexcept
+      : root_(nullptr), stack_size_(0), node_alloc_(alloc) {}
+  Stack(std::initializer_list<value_type> const& list,
+        const allocator_type& alloc = allocator_type())
+      : Stack(alloc) {
     for (const value_type& i : list) {
       push(i);
     }
   }
-  Stack(const Stack& other) noexcept { this->CopyStack(other); }
-  Stack(Stack&& other) noexcept { this->MoveStack((Stack &&) other); }
-  Stack& operator=(const Stack& other) noexcept {
+  Stack(const Stack& other)
+      : Stack(alloc_traits::select_on_container_copy_construction(
+            other.get_allocator())) {
     this->CopyStack(other);
-    return *this;
   }
-  Stack& operator=(Stack&& other) noexcept {
-    this->MoveStack((Stack &&) other);
+  Stack(Stack&& other) noexcept : Stack(other.get_allocator()) {
+    this->MoveStack(std::move(other));
+  }
+  Stack& operator=(const Stack& other) {
+    if (this != &other) {
+      Clear();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        node_alloc_ = other.node_alloc_;
+      }
+      this->CopyStack(other);
+    }
     return *this;
   }
-  ~Stack() noexcept {
-    while (root_ != nullptr) {
-      node* temp = root_;
-      root_ = root_->next_;
-      delete temp;
+  // values are moved one by one only if the nodes of other cannot be stolen
+  Stack& operator=(Stack&& other) {
+    if (this != &other) {
+      Clear();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        node_alloc_ = other.node_alloc_;
+      } else if (node_alloc_ != other.node_alloc_) {
+        CopyNodes(other.root_, [](value_type& value) -> value_type&& {
+          return std::move(value);
+        });
+        stack_size_ = other.stack_size_;
+        other.Clear();
+        return *this;
+      }
+      this->MoveStack(std::move(other));
     }
-    stack_size_ = 0;
+    return *this;
   }
+  ~Stack() noexcept { Clear(); }
 
-  void push(const_reference val) noexcept {
-    node* temp = new node;
-    temp->value_ = val;
-    if (root_) {
-      temp->next_ = root_;
-      root_ = temp;
-    } else {
-      root_ = temp;
-      root_->next_ = nullptr;
-    }
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(node_alloc_);
+  }
+
+  void push(const_reference val) {
+    root_ = CreateNode(val, root_);
     stack_size_++;
   }
 
   void pop() noexcept {
     if (root_) {
       node* temp = root_->next_;
-      delete root_;
+      DestroyNode(root_);
       root_ = temp;
       stack_size_--;
     }
@@ -71,6 +102,9 @@ class Stack {
     size_t temp_size = stack_size_;
     stack_size_ = other.stack_size_;
     other.stack_size_ = temp_size;
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(node_alloc_, other.node_alloc_);
+    }
   }
   bool empty() const noexcept { return root_ == nullptr; }
   const_reference top() const {
@@ -82,18 +116,11 @@ class Stack {
   size_type size() const noexcept { return stack_size_; }
 
   void CopyStack(const Stack& other) {
+    CopyNodes(other.root_,
+              [](const value_type& value) -> const value_type& {
+                return value;
+              });
     stack_size_ = other.stack_size_;
-    root_ = nullptr;
-    if (other.root_ != nullptr) {
-      root_ = new node{other.root_->value_, nullptr};
-      node* stack = root_;
-      node* stack_new = other.root_->next_;
-      while (stack_new != nullptr) {
-        stack->next_ = new node{stack_new->value_, nullptr};
-        stack = stack->next_;
-        stack_new = stack_new->next_;
-      }
-    }
   }
   void MoveStack(Stack&& other) {
     stack_size_ = other.stack_size_;
@@ -107,8 +134,46 @@ class Stack {
     value_type value_;
     node* next_;
   };
+
+  template <class V>
+  node* CreateNode(V&& value, node* next) {
+    node* temp = node_traits::allocate(node_alloc_, 1);
+    try {
+      ::new (static_cast<void*>(temp)) node{std::forward<V>(value), next};
+    } catch (...) {
+      node_traits::deallocate(node_alloc_, temp, 1);
+      throw;
+    }
+    return temp;
+  }
+
+  void DestroyNode(node* temp) noexcept {
+    temp->~node();
+    node_traits::deallocate(node_alloc_, temp, 1);
+  }
+
+  // rebuilds the chain starting at source in the same order
+  template <class Get>
+  void CopyNodes(node* source, Get get) {
+    node** tail = &root_;
+    for (; source != nullptr; source = source->next_) {
+      *tail = CreateNode(get(source->value_), nullptr);
+      tail = &(*tail)->next_;
+    }
+  }
+
+  void Clear() noexcept {
+    while (root_ != nullptr) {
+      node* temp = root_;
+      root_ = root_->next_;
+      DestroyNode(temp);
+    }
+    stack_size_ = 0;
+  }
+
   node* root_;
   size_type stack_size_;
+  [[no_unique_address]] node_allocator_type node_alloc_;
 };
 
 }  // namespace s21
@@ -0,0 +1,725 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_SWISS_TABLE_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_SWISS_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "s21_vector.h"
+
+namespace s21 {
+
+/*
+sixteen control bytes of a swiss table, compared all at once: with SSE2
+a match is one compare and one movemask, bit i of the result standing
+for byte i; elsewhere the bytes are compared one by one
+a full slot's byte is the top 7 bits of its hash (0..127), the others are
+negative: empty, deleted (a tombstone) or the sentinel closing the table
+*/
+class SwissGroup {
+ public:
+  using ctrl_type = signed char;
+
+  static constexpr std::size_t kWidth = 16;
+  static constexpr ctrl_type kEmpty = -128;
+  static constexpr ctrl_type kDeleted = -2;
+  static constexpr ctrl_type kSentinel = -1;
+
+  explicit SwissGroup(const ctrl_type* ctrl) noexcept {
+#if defined(__SSE2__)
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    std::memcpy(ctrl_, ctrl, kWidth);
+#endif
+  }
+
+  // the bytes equal to h2
+  std::uint32_t Match(ctrl_type h2) const noexcept {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+    }
+    return mask;
+#endif
+  }
+
+  std::uint32_t MatchEmpty() const noexcept { return Match(kEmpty); }
+
+  // empty and deleted are the bytes below the sentinel
+  std::uint32_t MatchEmptyOrDeleted() const noexcept {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_)));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl_[i] < kSentinel) << i;
+    }
+    return mask;
+#endif
+  }
+
+  // index of the lowest set bit of a nonzero mask
+  static std::size_t LowestBit(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+    std::size_t bit = 0;
+    for (; (mask & 1U) == 0U; mask >>= 1) ++bit;
+    return bit;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i ctrl_;
+#else
+  ctrl_type ctrl_[kWidth];
+#endif
+};
+
+// whether Hash and KeyEqual both take other types than the key
+template <class Hash, class KeyEqual, class = void>
+struct IsTransparentLookup : std::false_type {};
+
+template <class Hash, class KeyEqual>
+struct IsTransparentLookup<Hash, KeyEqual,
+                           std::void_t<typename Hash::is_transparent,
+                                       typename KeyEqual::is_transparent>>
+    : std::true_type {};
+
+/*
+open-addressing hash table in the swiss table layout: one control byte
+per slot, the slots split in aligned groups of SwissGroup::kWidth probed
+a group at a time; a lookup matches the 7 hash bits of the control bytes
+of a group against its own and only compares keys on a match, and stops
+at the first group holding an empty slot; groups are visited in
+triangular steps, which reach every group of a power-of-two table
+
+the table is at most 7/8 full; erasing marks the slot empty when its
+group already has an empty slot, as no probe went past such a group,
+and leaves a tombstone otherwise; tombstones are purged by the rehash
+that runs when no empty slot is left to take
+
+iterators and references are invalidated by a rehash, that is by an
+insertion that grows the table, and stay valid otherwise; the hash of
+Hash is mixed by a multiplication first, so identity hashes are fine
+*/
+template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual,
+          class Allocator = std::allocator<Value>>
+class SwissTable {
+ private:
+  template <bool Const>
+  class Iterator;
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using table_type =
+      SwissTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>;
+
+ private:
+  using ctrl_type = SwissGroup::ctrl_type;
+
+  static constexpr size_type kWidth = SwissGroup::kWidth;
+
+  struct Slot {
+    alignas(value_type) unsigned char storage_[sizeof(value_type)];
+  };
+
+  using alloc_traits = std::allocator_traits<allocator_type>;
+  using slot_allocator_type =
+      typename alloc_traits::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator_type>;
+  using ctrl_allocator_type =
+      typename alloc_traits::template rebind_alloc<ctrl_type>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator_type>;
+
+  // copies of such values are their bytes
+  static constexpr bool kBitwiseCopy =
+      std::is_trivially_copy_constructible_v<value_type> &&
+      std::is_trivially_destructible_v<value_type>;
+
+ public:
+  SwissTable() : SwissTable(0, hasher(), key_equal(), allocator_type()) {}
+
+  explicit SwissTable(const allocator_type& alloc)
+      : SwissTable(0, hasher(), key_equal(), alloc) {}
+
+  SwissTable(size_type bucket_count, const hasher& hash,
+             const key_equal& equal,
+             const allocator_type& alloc = allocator_type())
+      : ctrl_(nullptr),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        growth_left_(0),
+        hasher_(hash),
+        key_equal_(equal),
+        allocator_(alloc) {
+    if (bucket_count != 0) Resize(RoundCapacity(bucket_count));
+  }
+
+  SwissTable(const table_type& other)
+      : SwissTable(0, other.hasher_, other.key_equal_,
+                   alloc_traits::select_on_container_copy_construction(
+                       other.get_allocator())) {
+    CopyTable(other);
+  }
+
+  SwissTable(table_type&& other) noexcept
+      : SwissTable(0, other.hasher_, other.key_equal_,
+                   other.get_allocator()) {
+    SwapContents(other);
+  }
+
+  table_type& operator=(const table_type& other) {
+    if (this != &other) {
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (allocator_ != other.allocator_) {
+          clear();
+          ReleaseTable();
+          allocator_ = other.allocator_;
+        }
+      }
+      CopyTable(other);
+    }
+    return *this;
+  }
+
+  // values are moved one by one only if the slots of other cannot be stolen
+  table_type& operator=(table_type&& other) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                      value) {
+      // our slots go back to our allocator before it is replaced
+      ReleaseTable();
+      allocator_ = other.allocator_;
+    } else if constexpr (!alloc_traits::is_always_equal::value) {
+      if (allocator_ != other.allocator_) {
+        hasher_ = other.hasher_;
+        key_equal_ = other.key_equal_;
+        reserve(other.size_);
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+          EmplaceUnique(key_of_(*it), std::move(*it));
+        }
+        other.clear();
+        return *this;
+      }
+    }
+    SwapContents(other);
+    return *this;
+  }
+
+  ~SwissTable() {
+    clear();
+    ReleaseTable();
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
+  }
+
+  hasher hash_function() const { return hasher_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  iterator begin() noexcept {
+    if (size_ == 0) return end();
+    iterator it(ctrl_, slots_);
+    it.SkipFree();
+    return it;
+  }
+
+  iterator end() noexcept {
+    return iterator(ctrl_ + capacity_, slots_ + capacity_);
+  }
+
+  const_iterator begin() const noexcept {
+    return const_cast<table_type*>(this)->begin();
+  }
+
+  const_iterator end() const noexcept {
+    return const_cast<table_type*>(this)->end();
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / (sizeof(Slot) + 1) / 2;
+  }
+
+  // the number of slots, a power of two and a multiple of the group width
+  size_type capacity() const noexcept { return capacity_; }
+
+  // the slots are kept for the next insertions
+  void clear() noexcept {
+    if (capacity_ == 0) return;
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (IsFull(ctrl_[i])) ValueAt(i).~value_type();
+      }
+    }
+    ResetCtrl();
+    size_ = 0;
+  }
+
+  /*
+  after reserve(n) the table takes n values without a rehash; when the
+  room is only there once tombstones are gone, they are purged now
+  */
+  void reserve(size_type n) {
+    if (n > GrowthLimit(capacity_)) {
+      Resize(CapacityFor(n));
+    } else if (n > size_ && n - size_ > growth_left_) {
+      Resize(capacity_);
+    }
+  }
+
+  // at least n slots, and enough for the values held
+  void rehash(size_type n) {
+    size_type capacity = std::max(RoundCapacity(n), CapacityFor(size_));
+    if (size_ == 0 && n == 0) {
+      ReleaseTable();
+    } else if (capacity != capacity_) {
+      Resize(capacity);
+    }
+  }
+
+  template <class K>
+  iterator find(const K& key) noexcept {
+    return IteratorAt(FindIndex(key, HashOf(key)));
+  }
+
+  template <class K>
+  const_iterator find(const K& key) const noexcept {
+    return const_cast<table_type*>(this)->find(key);
+  }
+
+  template <class K>
+  bool contains(const K& key) const noexcept {
+    return FindIndex(key, HashOf(key)) != capacity_;
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return EmplaceUnique(key_of_(value), value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return EmplaceUnique(key_of_(value), std::move(value));
+  }
+
+  // the key is only known once the value is built
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return EmplaceUnique(key_of_(value), std::move(value));
+  }
+
+  /*
+  one probe: returns the value equal to key or builds one from args in
+  the first free slot of the probe; when the table has to grow the value
+  is built first, so args may refer to values of the table
+  */
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceUnique(const K& key, Args&&... args) {
+    std::uint64_t hash = HashOf(key);
+    size_type index = FindIndex(key, hash);
+    if (index != capacity_) return {IteratorAt(index), false};
+    if (capacity_ != 0) index = FindFreeSlot(hash);
+    if (capacity_ == 0 ||
+        (growth_left_ == 0 && ctrl_[index] == SwissGroup::kEmpty)) {
+      value_type value(std::forward<Args>(args)...);
+      Grow();
+      index = FindFreeSlot(hash);
+      ::new (static_cast<void*>(slots_[index].storage_))
+          value_type(std::move(value));
+    } else {
+      ::new (static_cast<void*>(slots_[index].storage_))
+          value_type(std::forward<Args>(args)...);
+    }
+    growth_left_ -= ctrl_[index] == SwissGroup::kEmpty ? 1 : 0;
+    ctrl_[index] = H2(hash);
+    ++size_;
+    return {IteratorAt(index), true};
+  }
+
+  // returns the iterator to the value after pos
+  iterator erase(const_iterator pos) noexcept {
+    size_type index = pos.slot_ - slots_;
+    EraseAt(index);
+    iterator next = IteratorAt(index);
+    next.SkipFree();
+    return next;
+  }
+
+  template <class K>
+  size_type erase(const K& key) noexcept {
+    size_type index = FindIndex(key, HashOf(key));
+    if (index == capacity_) return 0;
+    EraseAt(index);
+    return 1;
+  }
+
+  // moves in the values of other whose keys are missing here
+  void merge(table_type& other) {
+    if (this == &other) return;
+    for (size_type i = 0; i < other.capacity_; ++i) {
+      if (!IsFull(other.ctrl_[i])) continue;
+      value_type& value = other.ValueAt(i);
+      if (EmplaceUnique(key_of_(value), std::move(value)).second) {
+        other.EraseAt(i);
+      }
+    }
+  }
+
+  // allocators are exchanged only if they propagate on swap
+  void swap(table_type& other) noexcept {
+    SwapContents(other);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
+  }
+
+ private:
+  // (control byte, slot) pairs; ++ skips free slots a group at a time
+  template <bool Const>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Value*, Value*>;
+    using reference = std::conditional_t<Const, const Value&, Value&>;
+
+    Iterator() = default;
+
+    // iterator converts to const_iterator
+    template <bool C = Const, class = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& other)
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    reference operator*() const noexcept {
+      return *std::launder(reinterpret_cast<pointer>(slot_->storage_));
+    }
+
+    pointer operator->() const noexcept { return &**this; }
+
+    Iterator& operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      SkipFree();
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const Iterator& left,
+                           const Iterator& right) noexcept {
+      return left.ctrl_ == right.ctrl_;
+    }
+
+    friend bool operator!=(const Iterator& left,
+                           const Iterator& right) noexcept {
+      return left.ctrl_ != right.ctrl_;
+    }
+
+   private:
+    friend class SwissTable;
+    template <bool>
+    friend class Iterator;
+
+    Iterator(const ctrl_type* ctrl, Slot* slot) : ctrl_(ctrl), slot_(slot) {}
+
+    // to the next full slot or the sentinel
+    void SkipFree() noexcept {
+      while (*ctrl_ < SwissGroup::kSentinel) {
+        std::uint32_t free = SwissGroup(ctrl_).MatchEmptyOrDeleted();
+        size_type shift = SwissGroup::LowestBit(~free);
+        ctrl_ += shift;
+        slot_ += shift;
+      }
+    }
+
+    const ctrl_type* ctrl_ = nullptr;
+    Slot* slot_ = nullptr;
+  };
+
+  static bool IsFull(ctrl_type ctrl) noexcept { return ctrl >= 0; }
+
+  // the top bits of the product are the well mixed ones
+  template <class K>
+  std::uint64_t HashOf(const K& key) const noexcept {
+    std::uint64_t hash = static_cast<std::uint64_t>(hasher_(key)) *
+                         std::uint64_t{0x9E3779B97F4A7C15};
+    return hash ^ (hash >> 32);
+  }
+
+  static ctrl_type H2(std::uint64_t hash) noexcept {
+    return static_cast<ctrl_type>(hash >> 57);
+  }
+
+  static size_type GrowthLimit(size_type capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  static size_type RoundCapacity(size_type n) {
+    size_type capacity = kWidth;
+    while (capacity < n) {
+      if (capacity > std::numeric_limits<size_type>::max() / 4) {
+        throw std::length_error("value exceeds maximum size");
+      }
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // the smallest capacity that holds n values
+  static size_type CapacityFor(size_type n) {
+    return RoundCapacity(n + n / 7 + 1);
+  }
+
+  iterator IteratorAt(size_type index) noexcept {
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+  value_type& ValueAt(size_type index) noexcept {
+    return *std::launder(
+        reinterpret_cast<value_type*>(slots_[index].storage_));
+  }
+
+  const value_type& ValueAt(size_type index) const noexcept {
+    return *std::launder(
+        reinterpret_cast<const value_type*>(slots_[index].storage_));
+  }
+
+  // the slot holding key, capacity_ if there is none
+  template <class K>
+  size_type FindIndex(const K& key, std::uint64_t hash) const noexcept {
+    if (capacity_ == 0) return capacity_;
+    size_type group_mask = capacity_ / kWidth - 1;
+    size_type group = static_cast<size_type>(hash) & group_mask;
+    ctrl_type h2 = H2(hash);
+    for (size_type step = 1;; ++step) {
+      size_type first = group * kWidth;
+      SwissGroup ctrl(ctrl_ + first);
+      for (std::uint32_t match = ctrl.Match(h2); match != 0;
+           match &= match - 1) {
+        size_type index = first + SwissGroup::LowestBit(match);
+        if (key_equal_(key, key_of_(ValueAt(index)))) return index;
+      }
+      if (ctrl.MatchEmpty() != 0) return capacity_;
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // the first empty or deleted slot on the probe of hash
+  size_type FindFreeSlot(std::uint64_t hash) const noexcept {
+    size_type group_mask = capacity_ / kWidth - 1;
+    size_type group = static_cast<size_type>(hash) & group_mask;
+    for (size_type step = 1;; ++step) {
+      std::uint32_t free =
+          SwissGroup(ctrl_ + group * kWidth).MatchEmptyOrDeleted();
+      if (free != 0) return group * kWidth + SwissGroup::LowestBit(free);
+      group = (group + step) & group_mask;
+    }
+  }
+
+  void EraseAt(size_type index) noexcept {
+    ValueAt(index).~value_type();
+    --size_;
+    size_type first = index & ~(kWidth - 1);
+    if (SwissGroup(ctrl_ + first).MatchEmpty() != 0) {
+      ctrl_[index] = SwissGroup::kEmpty;
+      ++growth_left_;
+    } else {
+      ctrl_[index] = SwissGroup::kDeleted;
+    }
+  }
+
+  /*
+  doubles the table when more than half of its room holds values, and
+  otherwise rehashes it at the same size to purge the tombstones
+  */
+  void Grow() {
+    if (capacity_ == 0) {
+      Resize(kWidth);
+    } else if (size_ + 1 > GrowthLimit(capacity_) / 2) {
+      Resize(RoundCapacity(capacity_ * 2));
+    } else {
+      Resize(capacity_);
+    }
+  }
+
+  void ResetCtrl() noexcept {
+    std::memset(ctrl_, static_cast<unsigned char>(SwissGroup::kEmpty),
+                capacity_);
+    std::memset(ctrl_ + capacity_,
+                static_cast<unsigned char>(SwissGroup::kSentinel), kWidth);
+    growth_left_ = GrowthLimit(capacity_);
+  }
+
+  /*
+  moves every value into a new table of capacity slots; trivially
+  relocatable values go along with their bytes
+  */
+  void Resize(size_type capacity) {
+    ctrl_type* old_ctrl = ctrl_;
+    Slot* old_slots = slots_;
+    size_type old_capacity = capacity_;
+    size_type old_growth_left = growth_left_;
+    ctrl_allocator_type ctrl_allocator(allocator_);
+    slot_allocator_type slot_allocator(allocator_);
+    ctrl_type* ctrl = ctrl_traits::allocate(ctrl_allocator, capacity + kWidth);
+    Slot* slots = nullptr;
+    try {
+      slots = slot_traits::allocate(slot_allocator, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_allocator, ctrl, capacity + kWidth);
+      throw;
+    }
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = capacity;
+    ResetCtrl();
+    size_type moved = 0;
+    try {
+      for (; moved < old_capacity; ++moved) {
+        if (!IsFull(old_ctrl[moved])) continue;
+        value_type& value = *std::launder(
+            reinterpret_cast<value_type*>(old_slots[moved].storage_));
+        std::uint64_t hash = HashOf(key_of_(value));
+        size_type index = FindFreeSlot(hash);
+        if constexpr (is_trivially_relocatable_v<value_type>) {
+          std::memcpy(static_cast<void*>(slots_[index].storage_), &value,
+                      sizeof(value_type));
+        } else {
+          ::new (static_cast<void*>(slots_[index].storage_))
+              value_type(std::move_if_noexcept(value));
+        }
+        ctrl_[index] = H2(hash);
+        --growth_left_;
+      }
+    } catch (...) {
+      // the old table still holds every value, the new one copies of some
+      if constexpr (!is_trivially_relocatable_v<value_type>) {
+        for (size_type i = 0; i < capacity_; ++i) {
+          if (IsFull(ctrl_[i])) ValueAt(i).~value_type();
+        }
+      }
+      ReleaseTable();
+      ctrl_ = old_ctrl;
+      slots_ = old_slots;
+      capacity_ = old_capacity;
+      // the old tombstones are back too, so the old room is
+      growth_left_ = old_growth_left;
+      throw;
+    }
+    if constexpr (!is_trivially_relocatable_v<value_type>) {
+      for (size_type i = 0; i < old_capacity; ++i) {
+        if (IsFull(old_ctrl[i])) {
+          std::launder(reinterpret_cast<value_type*>(old_slots[i].storage_))
+              ->~value_type();
+        }
+      }
+    }
+    if (old_ctrl != nullptr) {
+      ctrl_traits::deallocate(ctrl_allocator, old_ctrl,
+                              old_capacity + kWidth);
+      slot_traits::deallocate(slot_allocator, old_slots, old_capacity);
+    }
+  }
+
+  void ReleaseTable() noexcept {
+    if (ctrl_ != nullptr) {
+      ctrl_allocator_type ctrl_allocator(allocator_);
+      slot_allocator_type slot_allocator(allocator_);
+      ctrl_traits::deallocate(ctrl_allocator, ctrl_, capacity_ + kWidth);
+      slot_traits::deallocate(slot_allocator, slots_, capacity_);
+    }
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+    growth_left_ = 0;
+  }
+
+  // a trivially copyable table is copied slot for slot, others are rebuilt
+  // everything but the allocators
+  void SwapContents(table_type& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hasher_, other.hasher_);
+    std::swap(key_equal_, other.key_equal_);
+  }
+
+  void CopyTable(const table_type& other) {
+    clear();
+    hasher_ = other.hasher_;
+    key_equal_ = other.key_equal_;
+    if (other.size_ == 0) return;
+    if constexpr (kBitwiseCopy) {
+      if (capacity_ != other.capacity_) {
+        ReleaseTable();
+        Resize(other.capacity_);
+      }
+      std::memcpy(ctrl_, other.ctrl_, capacity_ + kWidth);
+      std::memcpy(static_cast<void*>(slots_), other.slots_,
+                  capacity_ * sizeof(Slot));
+      size_ = other.size_;
+      growth_left_ = other.growth_left_;
+    } else {
+      reserve(other.size_);
+      for (const_iterator it = other.begin(); it != other.end(); ++it) {
+        EmplaceUnique(key_of_(*it), *it);
+      }
+    }
+  }
+
+  ctrl_type* ctrl_;
+  Slot* slots_;
+  size_type capacity_;
+  size_type size_;
+  size_type growth_left_;
+  [[no_unique_address]] hasher hasher_;
+  [[no_unique_address]] key_equal key_equal_;
+  [[no_unique_address]] KeyOfValue key_of_;
+  [[no_unique_address]] allocator_type allocator_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_SWISS_TABLE_H_
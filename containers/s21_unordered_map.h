@@ -0,0 +1,251 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_UNORDERED_MAP_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_UNORDERED_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../containers/s21_swiss_table.h"
+
+namespace s21 {
+/*
+hash map on a swiss table (see SwissTable): a lookup probes 16 control
+bytes at a time and compares keys only on a 7-bit hash match
+a Hash and a KeyEqual that are both transparent (is_transparent) enable
+lookups by any type they accept, e.g. std::string_view for std::string
+*/
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+ private:
+  class KeyOfValue;
+
+  // lookups by K are enabled by IsTransparentLookup
+  template <class K>
+  using RequireTransparent = std::enable_if_t<
+      IsTransparentLookup<Hash, KeyEqual>::value, K>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using table_type = SwissTable<key_type, value_type, KeyOfValue, hasher,
+                                key_equal, allocator_type>;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  unordered_map() : body_() {}
+
+  explicit unordered_map(size_type bucket_count,
+                         const hasher& hash = hasher(),
+                         const key_equal& equal = key_equal(),
+                         const allocator_type& alloc = allocator_type())
+      : body_(bucket_count, hash, equal, alloc) {}
+
+  explicit unordered_map(const allocator_type& alloc) : body_(alloc) {}
+
+  unordered_map(std::initializer_list<value_type> const& items,
+                size_type bucket_count = 0, const hasher& hash = hasher(),
+                const key_equal& equal = key_equal(),
+                const allocator_type& alloc = allocator_type())
+      : unordered_map(bucket_count, hash, equal, alloc) {
+    insert(items.begin(), items.end());
+  }
+
+  template <class InputIt>
+  unordered_map(InputIt first, InputIt last, size_type bucket_count = 0,
+                const hasher& hash = hasher(),
+                const key_equal& equal = key_equal(),
+                const allocator_type& alloc = allocator_type())
+      : unordered_map(bucket_count, hash, equal, alloc) {
+    insert(first, last);
+  }
+
+  unordered_map(const unordered_map& m) : body_(m.body_) {}
+
+  unordered_map(unordered_map&& m) noexcept : body_(std::move(m.body_)) {}
+
+  ~unordered_map() = default;
+
+  unordered_map& operator=(const unordered_map& m) {
+    body_ = m.body_;
+    return *this;
+  }
+
+  unordered_map& operator=(unordered_map&& m) {
+    body_ = std::move(m.body_);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return body_.get_allocator();
+  }
+
+  mapped_type& at(const Key& key) {
+    iterator it = body_.find(key);
+    if (it == end()) {
+      throw std::out_of_range("s21::unordered_map::at: key not found");
+    }
+    return it->second;
+  }
+
+  const mapped_type& at(const Key& key) const {
+    return const_cast<unordered_map*>(this)->at(key);
+  }
+
+  // one probe; mapped_type is value-initialized only for a new key
+  mapped_type& operator[](const Key& key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  iterator find(const Key& key) noexcept { return body_.find(key); }
+
+  const_iterator find(const Key& key) const noexcept {
+    return body_.find(key);
+  }
+
+  template <class K, class = RequireTransparent<K>>
+  iterator find(const K& key) noexcept {
+    return body_.find(key);
+  }
+
+  template <class K, class = RequireTransparent<K>>
+  const_iterator find(const K& key) const noexcept {
+    return body_.find(key);
+  }
+
+  bool contains(const Key& key) const noexcept { return body_.contains(key); }
+
+  template <class K, class = RequireTransparent<K>>
+  bool contains(const K& key) const noexcept {
+    return body_.contains(key);
+  }
+
+  size_type count(const Key& key) const noexcept {
+    return body_.contains(key) ? 1 : 0;
+  }
+
+  iterator begin() noexcept { return body_.begin(); }
+  iterator end() noexcept { return body_.end(); }
+  const_iterator begin() const noexcept { return body_.begin(); }
+  const_iterator end() const noexcept { return body_.end(); }
+  const_iterator cbegin() const noexcept { return body_.begin(); }
+  const_iterator cend() const noexcept { return body_.end(); }
+
+  bool empty() const noexcept { return body_.empty(); }
+
+  size_type size() const noexcept { return body_.size(); }
+
+  size_type max_size() const noexcept { return body_.max_size(); }
+
+  void clear() noexcept { body_.clear(); }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return body_.EmplaceUnique(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const mapped_type& obj) {
+    return body_.EmplaceUnique(key, key, obj);
+  }
+
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    std::pair<iterator, bool> result =
+        body_.EmplaceUnique(key, key, std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+    std::pair<iterator, bool> result =
+        body_.EmplaceUnique(key, std::move(key), std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  // mapped_type is built from args only if key is missing
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return body_.EmplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return body_.EmplaceUnique(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // builds the whole value first, as its key is not known before
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return body_.emplace(std::forward<Args>(args)...);
+  }
+
+  // returns the iterator to the element after pos
+  iterator erase(const_iterator pos) noexcept { return body_.erase(pos); }
+
+  size_type erase(const Key& key) noexcept { return body_.erase(key); }
+
+  void swap(unordered_map& other) noexcept { body_.swap(other.body_); }
+
+  // moves in the elements of other whose keys are missing here
+  void merge(unordered_map& other) { body_.merge(other.body_); }
+
+  // buckets are the slots of the table, at most 7/8 of them are used
+  size_type bucket_count() const noexcept { return body_.capacity(); }
+
+  float load_factor() const noexcept {
+    return bucket_count() == 0
+               ? 0.0f
+               : static_cast<float>(size()) /
+                     static_cast<float>(bucket_count());
+  }
+
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  void rehash(size_type count) { body_.rehash(count); }
+
+  // after reserve(n) the map takes n elements without a rehash
+  void reserve(size_type n) { body_.reserve(n); }
+
+  hasher hash_function() const { return body_.hash_function(); }
+
+  key_equal key_eq() const { return body_.key_eq(); }
+
+ private:
+  class KeyOfValue {
+   public:
+    const key_type& operator()(const_reference value) const noexcept {
+      return value.first;
+    }
+  };
+
+  table_type body_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_UNORDERED_MAP_H_
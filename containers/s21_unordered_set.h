@@ -0,0 +1,177 @@
+#ifndef CPP2_S21_CONTAINERS_CONTAINERS_S21_UNORDERED_SET_H_
+#define CPP2_S21_CONTAINERS_CONTAINERS_S21_UNORDERED_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../containers/s21_btree.h"
+#include "../containers/s21_swiss_table.h"
+
+namespace s21 {
+/*
+hash set on a swiss table (see SwissTable); a transparent Hash and
+KeyEqual enable lookups by any type they accept
+*/
+template <class Key, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<Key>>
+class unordered_set {
+ private:
+  // lookups by K are enabled by IsTransparentLookup
+  template <class K>
+  using RequireTransparent = std::enable_if_t<
+      IsTransparentLookup<Hash, KeyEqual>::value, K>;
+
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using table_type = SwissTable<key_type, value_type, IdentityKey, hasher,
+                                key_equal, allocator_type>;
+  // the elements are keys and cannot be changed in place
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+  unordered_set() : table_() {}
+
+  explicit unordered_set(size_type bucket_count,
+                         const hasher &hash = hasher(),
+                         const key_equal &equal = key_equal(),
+                         const allocator_type &alloc = allocator_type())
+      : table_(bucket_count, hash, equal, alloc) {}
+
+  explicit unordered_set(const allocator_type &alloc) : table_(alloc) {}
+
+  unordered_set(std::initializer_list<value_type> const &list,
+                size_type bucket_count = 0, const hasher &hash = hasher(),
+                const key_equal &equal = key_equal(),
+                const allocator_type &alloc = allocator_type())
+      : unordered_set(bucket_count, hash, equal, alloc) {
+    insert(list.begin(), list.end());
+  }
+
+  template <class InputIt>
+  unordered_set(InputIt first, InputIt last, size_type bucket_count = 0,
+                const hasher &hash = hasher(),
+                const key_equal &equal = key_equal(),
+                const allocator_type &alloc = allocator_type())
+      : unordered_set(bucket_count, hash, equal, alloc) {
+    insert(first, last);
+  }
+
+  unordered_set(const unordered_set &other) : table_(other.table_) {}
+
+  unordered_set(unordered_set &&other) noexcept
+      : table_(std::move(other.table_)) {}
+
+  unordered_set &operator=(const unordered_set &other) {
+    table_ = other.table_;
+    return *this;
+  }
+
+  unordered_set &operator=(unordered_set &&other) {
+    table_ = std::move(other.table_);
+    return *this;
+  }
+
+  ~unordered_set() = default;
+
+  allocator_type get_allocator() const noexcept {
+    return table_.get_allocator();
+  }
+
+  bool empty() const noexcept { return table_.empty(); }
+  size_type size() const noexcept { return table_.size(); }
+  size_type max_size() const noexcept { return table_.max_size(); }
+
+  std::pair<iterator, bool> insert(const value_type &val) {
+    return table_.insert(val);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&val) {
+    return table_.insert(std::move(val));
+  }
+
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return table_.emplace(std::forward<Args>(args)...);
+  }
+
+  iterator find(const key_type &key) const noexcept {
+    return table_.find(key);
+  }
+
+  template <class K, class = RequireTransparent<K>>
+  iterator find(const K &key) const noexcept {
+    return table_.find(key);
+  }
+
+  bool contains(const key_type &key) const noexcept {
+    return table_.contains(key);
+  }
+
+  template <class K, class = RequireTransparent<K>>
+  bool contains(const K &key) const noexcept {
+    return table_.contains(key);
+  }
+
+  size_type count(const key_type &key) const noexcept {
+    return table_.contains(key) ? 1 : 0;
+  }
+
+  // returns the iterator to the element after iter
+  iterator erase(const_iterator iter) noexcept { return table_.erase(iter); }
+
+  size_type erase(const key_type &key) noexcept { return table_.erase(key); }
+
+  void clear() noexcept { table_.clear(); }
+  void swap(unordered_set &other) noexcept { table_.swap(other.table_); }
+
+  // moves in the elements of other that are missing here
+  void merge(unordered_set &other) { table_.merge(other.table_); }
+
+  iterator begin() const noexcept { return table_.begin(); }
+  iterator end() const noexcept { return table_.end(); }
+  const_iterator cbegin() const noexcept { return table_.begin(); }
+  const_iterator cend() const noexcept { return table_.end(); }
+
+  // buckets are the slots of the table, at most 7/8 of them are used
+  size_type bucket_count() const noexcept { return table_.capacity(); }
+
+  float load_factor() const noexcept {
+    return bucket_count() == 0
+               ? 0.0f
+               : static_cast<float>(size()) /
+                     static_cast<float>(bucket_count());
+  }
+
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  void rehash(size_type count) { table_.rehash(count); }
+
+  // after reserve(n) the set takes n elements without a rehash
+  void reserve(size_type n) { table_.reserve(n); }
+
+  hasher hash_function() const { return table_.hash_function(); }
+
+  key_equal key_eq() const { return table_.key_eq(); }
+
+ private:
+  table_type table_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_UNORDERED_SET_H_
@@ -3,20 +3,172 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace s21 {
 
+/*
+a type is trivially relocatable when moving an object to new memory and
+ending the old one's lifetime is the same as copying its bytes; this
+holds for every trivially copyable type and may be specialized for others
+(e.g. types that own a heap pointer but never point into themselves)
+*/
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 template <class T>
-class Vector {
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// a pair relocates like its members, e.g. the values of maps
+template <class First, class Second>
+struct is_trivially_relocatable<std::pair<First, Second>>
+    : std::conjunction<is_trivially_relocatable<First>,
+                       is_trivially_relocatable<Second>> {};
+
+// the values of maps, whose key is const only to their users
+template <class T>
+struct IsConstKeyPair : std::false_type {};
+
+template <class First, class Second>
+struct IsConstKeyPair<std::pair<const First, Second>> : std::true_type {};
+
+/*
+slot as an rvalue, to build its replacement from; the const key of a map
+value is moved out as well, so slot must be destroyed right after and
+its key never read again
+*/
+template <class T>
+decltype(auto) MoveOutOfSlot(T &slot) noexcept {
+  if constexpr (IsConstKeyPair<T>::value) {
+    using First = std::remove_const_t<typename T::first_type>;
+    using Second = typename T::second_type;
+    return std::pair<First &&, Second &&>(
+        std::move(const_cast<First &>(slot.first)), std::move(slot.second));
+  } else {
+    return std::move(slot);
+  }
+}
+
+/*
+insertion into a contiguous buffer, shared by Vector and SmallVector
+Derived keeps its elements in arr_[0, size_) with room for capacity_ and
+provides Construct(p, args...) and Destroy(first, n); inserts that need
+another buffer go to InsertReallocating(index, count, grow, build), and
+ReallocationKeepsElements(index) tells whether the old elements stay
+readable while it builds
+*/
+template <class Derived, class T>
+class VectorInsertion {
+ protected:
+  using pointer = T *;
+  using size_type = std::size_t;
+
+  // constructs one element from each value, nothing is left on failure
+  template <class... Values>
+  void ConstructEach(pointer dest, Values &&...values) {
+    size_type built = 0U;
+    try {
+      (self().Construct(dest + built++, std::forward<Values>(values)), ...);
+    } catch (...) {
+      self().Destroy(dest, built - 1U);
+      throw;
+    }
+  }
+
+  // moves [index, size_) count slots right, the gap stays unconstructed
+  void OpenGap(size_type index, size_type count) noexcept {
+    Derived &vec = self();
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void *>(vec.arr_ + index + count),
+                   static_cast<const void *>(vec.arr_ + index),
+                   (vec.size_ - index) * sizeof(T));
+    } else {
+      for (size_type i = vec.size_; i > index; --i) {
+        vec.Construct(vec.arr_ + i - 1U + count, std::move(vec.arr_[i - 1U]));
+        vec.Destroy(vec.arr_ + i - 1U, 1U);
+      }
+    }
+  }
+
+  void CloseGap(size_type index, size_type count) noexcept {
+    Derived &vec = self();
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void *>(vec.arr_ + index),
+                   static_cast<const void *>(vec.arr_ + index + count),
+                   (vec.size_ - index) * sizeof(T));
+    } else {
+      for (size_type i = index; i < vec.size_; ++i) {
+        vec.Construct(vec.arr_ + i, std::move(vec.arr_[i + count]));
+        vec.Destroy(vec.arr_ + i + count, 1U);
+      }
+    }
+  }
+
+  /*
+  whether InsertBuilt leaves the current elements readable while build
+  runs, so it may construct straight from references into the vector
+  */
+  bool CanReadOwnElements(size_type index, size_type count) const noexcept {
+    const Derived &vec = static_cast<const Derived &>(*this);
+    if (vec.size_ + count > vec.capacity_) {
+      return vec.ReallocationKeepsElements(index);
+    }
+    return index == vec.size_ || !std::is_nothrow_move_constructible_v<T>;
+  }
+
+  /*
+  inserts count elements at index, build(dest) must construct all of them
+  at dest or construct nothing and throw
+  in place, the tail is moved once and build must not read from it;
+  growing inserts, and inserts of types whose move may throw, go through
+  InsertReallocating so a failure leaves the vector untouched
+  */
+  template <class Build>
+  void InsertBuilt(size_type index, size_type count, Build build) {
+    Derived &vec = self();
+    bool grow = vec.size_ + count > vec.capacity_;
+    if (grow ||
+        (index != vec.size_ && !std::is_nothrow_move_constructible_v<T>)) {
+      vec.InsertReallocating(index, count, grow, build);
+    } else if (index == vec.size_) {
+      build(vec.arr_ + vec.size_);
+    } else {
+      OpenGap(index, count);
+      try {
+        build(vec.arr_ + index);
+      } catch (...) {
+        CloseGap(index, count);
+        throw;
+      }
+    }
+    vec.size_ += count;
+  }
+
+ private:
+  Derived &self() noexcept { return static_cast<Derived &>(*this); }
+};
+
+template <class T, class Allocator = std::allocator<T>>
+class Vector : private VectorInsertion<Vector<T, Allocator>, T> {
  public:
   // types
   using value_type = T;
+  using allocator_type = Allocator;
   using pointer = value_type *;
   using const_pointer = const value_type *;
   using reference = value_type &;
@@ -27,44 +179,95 @@ class Vector {
   using reverse_iterator = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+ private:
+  using alloc_traits = std::allocator_traits<allocator_type>;
+
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Allocator::value_type must be the vector's value_type");
+  static_assert(std::is_same_v<typename alloc_traits::pointer, T *>,
+                "Vector only supports allocators with raw pointers");
+
+  using Insertion = VectorInsertion<Vector, T>;
+  friend Insertion;
+  using Insertion::CanReadOwnElements;
+  using Insertion::ConstructEach;
+  using Insertion::InsertBuilt;
+
+  template <class It>
+  using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+      typename std::iterator_traits<It>::iterator_category,
+      std::input_iterator_tag>>;
+
+ public:
   // constructors and destructors
-  explicit Vector() : arr_(nullptr), size_(0U), capacity_(0U) {}
+  Vector() noexcept(noexcept(allocator_type())) : Vector(allocator_type()) {}
 
-  explicit Vector(size_type n)
-      : arr_(n ? new value_type[n]() : nullptr), size_(n), capacity_(n) {
-    if (arr_) std::uninitialized_default_construct(begin(), end());
+  explicit Vector(const allocator_type &alloc) noexcept
+      : arr_(nullptr), size_(0U), capacity_(0U), alloc_(alloc) {}
+
+  explicit Vector(size_type n, const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    arr_ = Allocate(n);
+    capacity_ = n;
+    ValueConstruct(arr_, n);
+    size_ = n;
   }
 
-  explicit Vector(size_type n, const_reference value)
-      : arr_(n ? new value_type[n] : nullptr), size_(n), capacity_(n) {
-    if (arr_) std::uninitialized_fill(begin(), end(), value);
+  explicit Vector(size_type n, const_reference value,
+                  const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    arr_ = Allocate(n);
+    capacity_ = n;
+    FillConstruct(arr_, n, value);
+    size_ = n;
   }
 
-  Vector(std::initializer_list<value_type> const &items)
-      : arr_(items.size() ? new value_type[items.size()] : nullptr),
-        size_(items.size()),
-        capacity_(items.size()) {
-    std::uninitialized_copy(items.begin(), items.end(), begin());
+  Vector(std::initializer_list<value_type> const &items,
+         const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    arr_ = Allocate(items.size());
+    capacity_ = items.size();
+    CopyConstruct(items.begin(), items.end(), arr_);
+    size_ = items.size();
   }
 
-  Vector(const Vector &other) : size_(other.size_), capacity_(other.capacity_) {
-    arr_ = (capacity_ ? new value_type[capacity_]() : nullptr);
-    std::uninitialized_copy(other.cbegin(), other.cend(), begin());
+  Vector(const Vector &other)
+      : Vector(other, alloc_traits::select_on_container_copy_construction(
+                          other.alloc_)) {}
+
+  Vector(const Vector &other, const allocator_type &alloc) : Vector(alloc) {
+    arr_ = Allocate(other.capacity_);
+    capacity_ = other.capacity_;
+    CopyConstruct(other.cbegin(), other.cend(), arr_);
+    size_ = other.size_;
   }
 
-  Vector(Vector &&other) noexcept : arr_(nullptr), size_(0U), capacity_(0U) {
-    swap(*this, other);
+  Vector(Vector &&other) noexcept
+      : arr_(other.arr_),
+        size_(other.size_),
+        capacity_(other.capacity_),
+        alloc_(std::move(other.alloc_)) {
+    other.arr_ = nullptr;
+    other.size_ = other.capacity_ = 0U;
   }
 
-  ~Vector() {
-    if (arr_) {
-      for (size_type i = 0U; i < size_; ++i) {
-        arr_[i].~value_type();
-      }
-      delete[] arr_;
+  // O(1) when the allocators compare equal, element-wise moves otherwise
+  Vector(Vector &&other, const allocator_type &alloc) : Vector(alloc) {
+    if (alloc_ == other.alloc_) {
+      StealBuffer(other);
+    } else {
+      arr_ = Allocate(other.size_);
+      capacity_ = other.size_;
+      CopyConstruct(std::make_move_iterator(other.begin()),
+                    std::make_move_iterator(other.end()), arr_);
+      size_ = other.size_;
     }
   }
 
+  ~Vector() { FreeStorage(); }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
   // accessors and mutators
 
   reference at(size_type index) {
@@ -98,107 +301,181 @@ class Vector {
     if (new_capacity > max_size()) {
       throw std::length_error("value exceeds maximum size");
     }
-    pointer new_arr = new value_type[new_capacity]();
-    std::move(begin(), end(), new_arr);
-    if (arr_ != nullptr) delete[] arr_;
-    arr_ = new_arr;
-    capacity_ = new_capacity;
+    Reallocate(new_capacity);
   }
   size_type capacity() const noexcept { return capacity_; }
   void shrink_to_fit() {
     if (size_ == capacity_) return;
-    if (size_ == 0U) {
-      delete[] arr_;
-      arr_ = nullptr;
-      capacity_ = 0U;
+    Reallocate(size_);
+  }
+
+  void clear() noexcept {
+    Destroy(arr_, size_);
+    size_ = 0U;
+  }
+
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
+    size_type index = pos - cbegin();
+    if (count == 0U) return begin() + index;
+    if (CanReadOwnElements(index, count)) {
+      InsertBuilt(index, count,
+                  [&](pointer dest) { FillConstruct(dest, count, value); });
     } else {
-      pointer new_arr = new value_type[size_];
-      std::move(begin(), end(), new_arr);
-      delete[] arr_;
-      arr_ = new_arr;
-      capacity_ = size_;
+      // value may refer to an element that is about to be shifted
+      value_type tmp(value);
+      InsertBuilt(index, count,
+                  [&](pointer dest) { FillConstruct(dest, count, tmp); });
     }
+    return begin() + index;
   }
 
-  void clear() noexcept { size_ = 0U; }
-
-  iterator insert(iterator pos, const_reference value) {
-    size_type diff = pos - begin();
-    if (size_ == capacity_) {
-      reserve(capacity_ == 0U ? 1U : capacity_ * 2U);
-      pos = begin() + diff;
+  // the range must not point into this vector
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    size_type index = pos - cbegin();
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_type count = std::distance(first, last);
+      if (count != 0U) {
+        InsertBuilt(index, count,
+                    [&](pointer dest) { CopyConstruct(first, last, dest); });
+      }
+    } else {
+      // single pass ranges are collected first to learn their length
+      Vector buffer(alloc_);
+      for (; first != last; ++first) buffer.emplace_back(*first);
+      insert(pos, std::make_move_iterator(buffer.begin()),
+             std::make_move_iterator(buffer.end()));
     }
-    if (size_ != 0U) {
-      *end() = std::move(*(end() - 1));
+    return begin() + index;
+  }
+
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = pos - cbegin();
+    if (CanReadOwnElements(index, 1U)) {
+      InsertBuilt(index, 1U, [&](pointer dest) {
+        Construct(dest, std::forward<Args>(args)...);
+      });
+    } else {
+      // args may refer to an element that is about to be shifted
+      value_type tmp(std::forward<Args>(args)...);
+      InsertBuilt(index, 1U,
+                  [&](pointer dest) { Construct(dest, std::move(tmp)); });
     }
-    std::rotate(pos, end(), end() + 1);
-    *pos = value;
-    ++size_;
-    return pos;
+    return begin() + index;
   }
 
+  // every argument becomes one element, the tail is shifted once
   template <class... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
-    iterator it_current{const_cast<value_type *>(pos)};
-    for (auto value : {std::forward<Args>(args)...}) {
-      it_current = insert(it_current, std::move(value));
-      ++it_current;
+    constexpr size_type count = sizeof...(Args);
+    size_type index = pos - cbegin();
+    if constexpr (count == 0U) {
+      return begin() + index;
+    } else {
+      if (CanReadOwnElements(index, count)) {
+        InsertBuilt(index, count, [&](pointer dest) {
+          ConstructEach(dest, std::forward<Args>(args)...);
+        });
+      } else {
+        // same as in emplace: build the values before the tail moves
+        alignas(value_type) unsigned char buffer[count * sizeof(value_type)];
+        pointer tmp = reinterpret_cast<pointer>(buffer);
+        ConstructEach(tmp, std::forward<Args>(args)...);
+        try {
+          InsertBuilt(index, count, [&](pointer dest) {
+            Relocate(tmp, count, dest);
+          });
+        } catch (...) {
+          Destroy(tmp, count);
+          throw;
+        }
+        Destroy(tmp, count);
+      }
+      return begin() + index + count - 1U;
     }
-    return --it_current;
   }
 
   template <class... Args>
   void insert_many_back(Args &&...args) {
-    for (auto value : {std::forward<Args>(args)...}) {
-      push_back(std::move(value));
-    }
+    insert_many(cend(), std::forward<Args>(args)...);
   }
 
-  void erase(iterator pos) {
-    if (pos == end() - 1) {
-      --size_;
-    } else {
-      std::rotate(pos, pos + 1, end());
-      --size_;
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = first - cbegin();
+    size_type count = last - first;
+    if (count != 0U) {
+      iterator dest = begin() + index;
+      std::move(dest + count, end(), dest);
+      Destroy(end() - count, count);
+      size_ -= count;
     }
+    return begin() + index;
   }
 
-  void push_back(const_reference value) {
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
     if (size_ == capacity_) {
-      reserve(capacity_ == 0U ? 1U : capacity_ * 2U);
+      emplace(cend(), std::forward<Args>(args)...);
+    } else {
+      Construct(end(), std::forward<Args>(args)...);
+      ++size_;
     }
-    *(end()) = value;
-    ++size_;
+    return back();
   }
 
-  void pop_back() noexcept { --size_; }
+  void pop_back() noexcept {
+    --size_;
+    alloc_traits::destroy(alloc_, arr_ + size_);
+  }
 
   void resize(const size_type count) {
-    if (capacity_ < count) {
-      reserve(capacity_ == 0U ? 1U : capacity_ * 2U);
-      if (capacity_ < count) reserve(count);
-    }
-    if (size_ < count) {
-      std::uninitialized_default_construct(begin() + size_, begin() + count);
+    if (count <= size_) {
+      Destroy(begin() + count, size_ - count);
+    } else {
+      if (capacity_ < count) Reallocate(GrowthCapacity(count));
+      ValueConstruct(end(), count - size_);
     }
     size_ = count;
   }
 
   void resize(const size_type count, const_reference value) {
-    if (capacity_ < count) {
-      reserve(capacity_ == 0U ? 1U : capacity_ * 2U);
-      if (capacity_ < count) reserve(count);
-    }
-    if (size_ < count) {
-      std::fill_n(end(), count - size_, value);
+    if (count <= size_) {
+      Destroy(begin() + count, size_ - count);
+      size_ = count;
+    } else {
+      insert(cend(), count - size_, value);
     }
-    size_ = count;
   }
 
+  /*
+  always O(1); allocators are swapped only if they propagate on swap,
+  otherwise they must compare equal
+  */
   friend void swap(Vector &lhs, Vector &rhs) noexcept {
     std::swap(lhs.arr_, rhs.arr_);
     std::swap(lhs.size_, rhs.size_);
     std::swap(lhs.capacity_, rhs.capacity_);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(lhs.alloc_, rhs.alloc_);
+    }
   }
 
   // iterators
@@ -236,34 +513,365 @@ class Vector {
 
   Vector &operator=(const Vector &other) {
     if (this != &other) {
-      if (capacity_ < other.size_) {
-        delete[] arr_;
-        arr_ = new value_type[other.size_];
-        capacity_ = other.size_;
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (alloc_ != other.alloc_) {
+          // memory of the old allocator goes back to it before the switch
+          FreeStorage();
+          arr_ = nullptr;
+          size_ = capacity_ = 0U;
+        }
+        alloc_ = other.alloc_;
       }
-      size_ = other.size_;
-      std::copy(other.cbegin(), other.cend(), begin());
+      AssignElements(other.cbegin(), other.size_);
     }
     return *this;
   }
 
-  Vector &operator=(Vector &&other) noexcept {
+  /*
+  O(1) when the allocator propagates or both allocators compare equal,
+  otherwise the elements are moved one by one into this vector's memory
+  */
+  Vector &operator=(Vector &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
     if (this != &other) {
-      delete[] arr_;
-      size_ = other.size_;
-      capacity_ = other.capacity_;
-      arr_ = other.arr_;
-      other.arr_ = nullptr;
-      other.size_ = other.capacity_ = 0U;
+      constexpr bool propagate =
+          alloc_traits::propagate_on_container_move_assignment::value;
+      if (propagate || alloc_ == other.alloc_) {
+        FreeStorage();
+        arr_ = nullptr;
+        size_ = capacity_ = 0U;
+        if constexpr (propagate) alloc_ = std::move(other.alloc_);
+        StealBuffer(other);
+      } else {
+        AssignElements(std::make_move_iterator(other.begin()), other.size_);
+        other.clear();
+      }
     }
     return *this;
   }
 
  private:
+  /*
+  storage is raw memory: only [0, size_) holds constructed elements,
+  spare capacity is never constructed
+  trivially relocatable types live in malloc memory, so growth is a
+  realloc; buffers of kMapBytes and more are mapped directly and grown
+  with mremap, which moves page table entries instead of bytes
+  */
+  static constexpr bool kStdAllocator =
+      std::is_same_v<allocator_type, std::allocator<value_type>>;
+  static constexpr bool kRawStorage =
+      kStdAllocator && is_trivially_relocatable_v<value_type> &&
+      alignof(value_type) <= alignof(std::max_align_t);
+  static constexpr std::size_t kMapBytes = std::size_t{1} << 25;
+
+  pointer Allocate(size_type n) {
+    if (n == 0U) return nullptr;
+    if (n > max_size()) {
+      throw std::length_error("value exceeds maximum size");
+    }
+    if constexpr (kRawStorage) {
+      return static_cast<pointer>(RawAllocate(n * sizeof(value_type)));
+    } else {
+      return alloc_traits::allocate(alloc_, n);
+    }
+  }
+
+  void Deallocate(pointer p, size_type n) noexcept {
+    if (p == nullptr) return;
+    if constexpr (kRawStorage) {
+      RawDeallocate(p, n * sizeof(value_type));
+    } else {
+      alloc_traits::deallocate(alloc_, p, n);
+    }
+  }
+
+  void FreeStorage() noexcept {
+    Destroy(arr_, size_);
+    Deallocate(arr_, capacity_);
+  }
+
+  // takes the buffer of other, this vector must own no memory
+  void StealBuffer(Vector &other) noexcept {
+    arr_ = other.arr_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.arr_ = nullptr;
+    other.size_ = other.capacity_ = 0U;
+  }
+
+  /*
+  element construction goes through the allocator; std::allocator uses
+  the std::uninitialized_* algorithms, which turn into memmove for
+  trivial types; every helper destroys what it built if it throws
+  */
+  template <class... Args>
+  void Construct(pointer p, Args &&...args) {
+    alloc_traits::construct(alloc_, p, std::forward<Args>(args)...);
+  }
+
+  void Destroy(pointer first, size_type n) noexcept {
+    if constexpr (kStdAllocator) {
+      std::destroy_n(first, n);
+    } else {
+      for (size_type i = 0U; i < n; ++i) {
+        alloc_traits::destroy(alloc_, first + i);
+      }
+    }
+  }
+
+  template <class It>
+  void CopyConstruct(It first, It last, pointer dest) {
+    if constexpr (kStdAllocator) {
+      std::uninitialized_copy(first, last, dest);
+    } else {
+      size_type built = 0U;
+      try {
+        for (; first != last; ++first, ++built) Construct(dest + built, *first);
+      } catch (...) {
+        Destroy(dest, built);
+        throw;
+      }
+    }
+  }
+
+  void FillConstruct(pointer dest, size_type n, const_reference value) {
+    if constexpr (kStdAllocator) {
+      std::uninitialized_fill_n(dest, n, value);
+    } else {
+      size_type built = 0U;
+      try {
+        for (; built < n; ++built) Construct(dest + built, value);
+      } catch (...) {
+        Destroy(dest, built);
+        throw;
+      }
+    }
+  }
+
+  void ValueConstruct(pointer dest, size_type n) {
+    if constexpr (kStdAllocator) {
+      std::uninitialized_value_construct_n(dest, n);
+    } else {
+      size_type built = 0U;
+      try {
+        for (; built < n; ++built) Construct(dest + built);
+      } catch (...) {
+        Destroy(dest, built);
+        throw;
+      }
+    }
+  }
+
+  // copy (or move) assignment of n elements that keeps the allocator
+  template <class It>
+  void AssignElements(It first, size_type n) {
+    if (capacity_ < n) {
+      pointer new_arr = Allocate(n);
+      try {
+        CopyConstruct(first, std::next(first, n), new_arr);
+      } catch (...) {
+        Deallocate(new_arr, n);
+        throw;
+      }
+      FreeStorage();
+      arr_ = new_arr;
+      capacity_ = n;
+    } else if (size_ < n) {
+      It middle = std::next(first, size_);
+      std::copy(first, middle, begin());
+      CopyConstruct(middle, std::next(middle, n - size_), end());
+    } else {
+      std::copy(first, std::next(first, n), begin());
+      Destroy(begin() + n, size_ - n);
+    }
+    size_ = n;
+  }
+
+  static void *RawAllocate(std::size_t bytes) {
+#if defined(__linux__)
+    if (bytes >= kMapBytes) {
+      void *p = mmap(nullptr, PageRound(bytes), PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) throw std::bad_alloc();
+      return p;
+    }
+#endif
+    void *p = std::malloc(bytes);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+  }
+
+  static void RawDeallocate(void *p, std::size_t bytes) noexcept {
+#if defined(__linux__)
+    if (bytes >= kMapBytes) {
+      munmap(p, PageRound(bytes));
+      return;
+    }
+#endif
+    (void)bytes;
+    std::free(p);
+  }
+
+  // the block keeps its first used bytes, on failure it is left untouched
+  static void *RawReallocate(void *p, std::size_t old_bytes,
+                             std::size_t new_bytes, std::size_t used) {
+    if (p == nullptr) return RawAllocate(new_bytes);
+#if defined(__linux__)
+    if (old_bytes >= kMapBytes && new_bytes >= kMapBytes) {
+      void *q = mremap(p, PageRound(old_bytes), PageRound(new_bytes),
+                       MREMAP_MAYMOVE);
+      if (q == MAP_FAILED) throw std::bad_alloc();
+      return q;
+    }
+    if (old_bytes >= kMapBytes || new_bytes >= kMapBytes) {
+      void *q = RawAllocate(new_bytes);
+      std::memcpy(q, p, used);
+      RawDeallocate(p, old_bytes);
+      return q;
+    }
+#endif
+    (void)old_bytes;
+    (void)used;
+    void *q = std::realloc(p, new_bytes);
+    if (q == nullptr) throw std::bad_alloc();
+    return q;
+  }
+
+#if defined(__linux__)
+  static std::size_t PageRound(std::size_t bytes) noexcept {
+    static const std::size_t page =
+        static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1U) / page * page;
+  }
+#endif
+
+  /*
+  capacity after a growth that must fit at least min_capacity elements:
+  the size is doubled, or grown straight to min_capacity if that is more
+  */
+  size_type GrowthCapacity(size_type min_capacity) const {
+    if (min_capacity > max_size()) {
+      throw std::length_error("value exceeds maximum size");
+    }
+    size_type doubled = size_ > max_size() - size_ ? max_size() : size_ * 2U;
+    return std::max(doubled, min_capacity);
+  }
+
+  // moves (or copies, if moving may throw) n elements into raw memory
+  void Relocate(pointer first, size_type n, pointer dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                  !std::is_copy_constructible_v<value_type>) {
+      CopyConstruct(std::make_move_iterator(first),
+                    std::make_move_iterator(first + n), dest);
+    } else {
+      CopyConstruct(first, first + n, dest);
+    }
+  }
+
+  /*
+  moves the elements into new_arr leaving a gap of gap_size already
+  constructed elements at index; the gap is destroyed if relocation throws
+  */
+  void AdoptBuffer(pointer new_arr, size_type new_capacity, size_type index,
+                   size_type gap_size) {
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      if (index != 0U) {
+        std::memcpy(static_cast<void *>(new_arr),
+                    static_cast<const void *>(arr_),
+                    index * sizeof(value_type));
+      }
+      if (size_ != index) {
+        std::memcpy(static_cast<void *>(new_arr + index + gap_size),
+                    static_cast<const void *>(arr_ + index),
+                    (size_ - index) * sizeof(value_type));
+      }
+      Deallocate(arr_, capacity_);
+      arr_ = new_arr;
+      capacity_ = new_capacity;
+      return;
+    }
+    try {
+      Relocate(arr_, index, new_arr);
+      try {
+        Relocate(arr_ + index, size_ - index, new_arr + index + gap_size);
+      } catch (...) {
+        Destroy(new_arr, index);
+        throw;
+      }
+    } catch (...) {
+      Destroy(new_arr + index, gap_size);
+      Deallocate(new_arr, new_capacity);
+      throw;
+    }
+    FreeStorage();
+    arr_ = new_arr;
+    capacity_ = new_capacity;
+  }
+
+  void Reallocate(size_type new_capacity) {
+    if constexpr (kRawStorage) {
+      if (new_capacity == 0U) {
+        Deallocate(arr_, capacity_);
+        arr_ = nullptr;
+      } else {
+        arr_ = static_cast<pointer>(RawReallocate(
+            arr_, capacity_ * sizeof(value_type),
+            new_capacity * sizeof(value_type), size_ * sizeof(value_type)));
+      }
+      capacity_ = new_capacity;
+    } else {
+      pointer new_arr = Allocate(new_capacity);
+      AdoptBuffer(new_arr, new_capacity, size_, 0U);
+    }
+  }
+
+  // called by InsertBuilt, see VectorInsertion
+  bool ReallocationKeepsElements(size_type index) const noexcept {
+    return !kRawStorage || index != size_;
+  }
+
+  /*
+  the elements are built in the new buffer before the old one is freed,
+  except for appends to raw storage, which reallocate first
+  */
+  template <class Build>
+  void InsertReallocating(size_type index, size_type count, bool grow,
+                          Build build) {
+    if (kRawStorage && grow && index == size_) {
+      Reallocate(GrowthCapacity(size_ + count));
+      build(end());
+      return;
+    }
+    size_type new_capacity = grow ? GrowthCapacity(size_ + count) : capacity_;
+    pointer new_arr = Allocate(new_capacity);
+    try {
+      build(new_arr + index);
+    } catch (...) {
+      Deallocate(new_arr, new_capacity);
+      throw;
+    }
+    AdoptBuffer(new_arr, new_capacity, index, count);
+  }
+
   value_type *arr_;
   size_type size_;
   size_type capacity_;
+  // stateless allocators take no space
+  [[no_unique_address]] allocator_type alloc_;
 };
+
+// removes every element matching pred in one pass, returns their number
+template <class T, class Allocator, class Pred>
+typename Vector<T, Allocator>::size_type erase_if(Vector<T, Allocator> &vec,
+                                                  Pred pred) {
+  auto last = std::remove_if(vec.begin(), vec.end(), pred);
+  typename Vector<T, Allocator>::size_type count = vec.end() - last;
+  vec.erase(last, vec.end());
+  return count;
+}
 }  // namespace s21
 
 #endif  // CPP2_S21_CONTAINERS_CONTAINERS_S21_VECTOR_H_
@@ -2,11 +2,18 @@
 #define CPP2_S21_CONTAINERS_S21_CONTAINERS_H_
 
 #include "containers/s21_array.h"
+#include "containers/s21_concurrent_unordered_map.h"
+#include "containers/s21_flat_map.h"
+#include "containers/s21_flat_set.h"
 #include "containers/s21_list.h"
 #include "containers/s21_map.h"
+#include "containers/s21_memory_resource.h"
 #include "containers/s21_queue.h"
 #include "containers/s21_set.h"
+#include "containers/s21_small_vector.h"
 #include "containers/s21_stack.h"
+#include "containers/s21_unordered_map.h"
+#include "containers/s21_unordered_set.h"
 #include "containers/s21_vector.h"
 
 #endif  // CPP2_S21_CONTAINERS_S21_CONTAINERS_H_
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include "tests/array_test.cc"
+#include "tests/concurrent_unordered_map_test.cc"
+#include "tests/flat_map_test.cc"
 #include "tests/list_test.cc"
 #include "tests/map_test.cc"
+#include "tests/memory_resource_test.cc"
 #include "tests/set_stack_queue_test.cc"
+#include "tests/small_vector_test.cc"
+#include "tests/unordered_map_test.cc"
 #include "tests/vector_test.cc"
 
 int main(int argc, char** argv) {
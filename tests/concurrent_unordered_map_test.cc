@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../containers/s21_concurrent_unordered_map.h"
+#include "../containers/s21_memory_resource.h"
+
+namespace {
+// has no default constructor, so only the given instance can be used
+struct SeededHash {
+  explicit SeededHash(std::size_t value) : seed(value) {}
+  std::size_t operator()(int key) const noexcept {
+    return static_cast<std::size_t>(key) * 31U + seed;
+  }
+  std::size_t seed;
+};
+
+TEST(CONCURRENT_UNORDERED_MAP, PARALLEL_UPDATES_ARE_NOT_LOST) {
+  s21::concurrent_unordered_map<int, long> totals(8);
+  const int kThreads = 8;
+  const int kUpdates = 20000;
+  const int kKeys = 500;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&totals, t] {
+      for (int i = 0; i < kUpdates; ++i) {
+        totals.update_or_insert((i * 7 + t) % kKeys,
+                                [](long& total) { ++total; });
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(totals.size(), static_cast<std::size_t>(kKeys));
+  long sum = 0;
+  totals.for_each_shard([&sum](const auto& shard) {
+    for (const auto& item : shard) sum += item.second;
+  });
+  EXPECT_EQ(sum, static_cast<long>(kThreads) * kUpdates);
+  EXPECT_EQ(totals.snapshot().size(), static_cast<std::size_t>(kKeys));
+}
+
+TEST(CONCURRENT_UNORDERED_MAP, LOOKUP_INSERT_AND_ERASE) {
+  s21::concurrent_unordered_map<std::string, int> table(5);
+  EXPECT_EQ(table.shard_count(), 8U);
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(table.insert({"a", 1}));
+  EXPECT_FALSE(table.insert({"a", 2}));
+  EXPECT_TRUE(table.try_emplace("b", 2));
+  EXPECT_FALSE(table.insert_or_assign("b", 20));
+  EXPECT_EQ(table.get("b"), 20);
+  EXPECT_FALSE(table.get("c").has_value());
+  EXPECT_TRUE(table.update("a", [](int& value) { value += 10; }));
+  EXPECT_FALSE(table.update("c", [](int& value) { value += 10; }));
+  int seen = 0;
+  EXPECT_TRUE(table.visit("a", [&seen](const int& value) { seen = value; }));
+  EXPECT_EQ(seen, 11);
+  std::size_t in_shard = 0;
+  table.visit_shard(table.shard_of("a"), [&in_shard](const auto& shard) {
+    in_shard = shard.count("a");
+  });
+  EXPECT_EQ(in_shard, 1U);
+  EXPECT_EQ(table.erase("a"), 1U);
+  EXPECT_FALSE(table.contains("a"));
+  table.reserve(1000);
+  table.clear();
+  EXPECT_EQ(table.size(), 0U);
+}
+
+TEST(CONCURRENT_UNORDERED_MAP, SHARDS_KEEP_HASH_AND_ALLOCATOR) {
+  using Alloc = std::pmr::polymorphic_allocator<std::pair<const int, int>>;
+  s21::CountingResource counting;
+  s21::concurrent_unordered_map<int, int, SeededHash, std::equal_to<int>,
+                                Alloc>
+      table(4, SeededHash(7), std::equal_to<int>(), Alloc(&counting));
+  for (int i = 0; i < 100; ++i) table.insert({i, i});
+  EXPECT_GT(counting.stats().allocations, 0U);
+  table.for_each_shard([&counting](const auto& shard) {
+    EXPECT_EQ(shard.get_allocator().resource(), &counting);
+    EXPECT_EQ(shard.hash_function().seed, 7U);
+  });
+  auto copy = table.snapshot();
+  EXPECT_EQ(copy.size(), 100U);
+  EXPECT_EQ(copy.get_allocator().resource(), &counting);
+  EXPECT_EQ(copy.hash_function().seed, 7U);
+}
+}  // namespace
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../containers/s21_flat_map.h"
+#include "../containers/s21_flat_set.h"
+
+namespace {
+// a key whose move constructor throws when bomb is set
+struct MoveBomb {
+  MoveBomb(int value, bool armed = false) : key(value), bomb(armed) {}
+  MoveBomb(const MoveBomb& other) = default;
+  MoveBomb(MoveBomb&& other) : key(other.key), bomb(other.bomb) {
+    if (bomb) throw std::runtime_error("MoveBomb");
+  }
+  MoveBomb& operator=(const MoveBomb& other) = default;
+  bool operator<(const MoveBomb& other) const { return key < other.key; }
+
+  int key;
+  bool bomb;
+};
+
+TEST(FLAT_MAP, INSERT_FIND_AND_ERASE) {
+  s21::flat_map<int, std::string> table{{5, "five"}, {1, "one"}, {3, "three"},
+                                        {1, "uno"}};
+  EXPECT_EQ(table.size(), 3U);
+  EXPECT_EQ(table.at(1), "one");
+  EXPECT_THROW(table.at(2), std::out_of_range);
+  EXPECT_TRUE(table.insert({2, "two"}).second);
+  EXPECT_FALSE(table.insert({2, "deux"}).second);
+  EXPECT_FALSE(table.insert_or_assign(2, "deux").second);
+  EXPECT_EQ(table[2], "deux");
+  table[4] = "four";
+  EXPECT_EQ((*table.find(4)).second, "four");
+  EXPECT_EQ(table.find(7), table.end());
+  EXPECT_EQ(table.insert(table.end(), {6, "six"})->first, 6);
+  EXPECT_EQ(table.emplace_hint(table.begin(), 0, "zero")->second, "zero");
+  EXPECT_EQ(table.erase(3), 1U);
+  EXPECT_EQ(table.erase(3), 0U);
+  auto next = table.erase(table.find(0));
+  EXPECT_EQ(next->first, 1);
+  std::vector<int> keys(table.keys().cbegin(), table.keys().cend());
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 4, 5, 6}));
+  std::vector<int> reversed;
+  for (auto it = table.rbegin(); it != table.rend(); ++it) {
+    reversed.push_back((*it).first);
+  }
+  EXPECT_EQ(reversed, (std::vector<int>{6, 5, 4, 2, 1}));
+  EXPECT_EQ(table.rank(4), 2U);
+  EXPECT_EQ(table.select(3)->second, "five");
+}
+
+TEST(FLAT_MAP, BOUNDS_AGREE_WITH_STD_MAP) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 400);
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 300; ++i) items.emplace_back(dist(gen), i);
+  s21::flat_map<int, int> table(items.begin(), items.end());
+  std::map<int, int> expected;
+  for (const auto& item : items) expected.insert(item);
+  ASSERT_EQ(table.size(), expected.size());
+  EXPECT_TRUE(std::equal(table.begin(), table.end(), expected.begin(),
+                         [](const auto& left, const auto& right) {
+                           return left.first == right.first &&
+                                  left.second == right.second;
+                         }));
+  for (int key = -1; key <= 401; ++key) {
+    auto lower = expected.lower_bound(key);
+    auto upper = expected.upper_bound(key);
+    EXPECT_EQ(table.lower_bound(key) - table.begin(),
+              std::distance(expected.begin(), lower));
+    EXPECT_EQ(table.upper_bound(key) - table.begin(),
+              std::distance(expected.begin(), upper));
+    auto range = table.equal_range(key);
+    EXPECT_EQ(range.second - range.first, expected.count(key));
+    EXPECT_EQ(table.contains(key), expected.count(key) == 1U);
+  }
+  int sum = 0;
+  for (auto item : table.range(100, 200)) sum += item.first;
+  int expected_sum = 0;
+  for (auto it = expected.lower_bound(100); it != expected.lower_bound(200);
+       ++it) {
+    expected_sum += it->first;
+  }
+  EXPECT_EQ(sum, expected_sum);
+}
+
+TEST(FLAT_MAP, INSERT_RANGE_MERGES_BATCHES) {
+  s21::flat_map<int, std::string> table{{2, "b"}, {4, "d"}};
+  std::vector<std::pair<int, std::string>> batch{
+      {5, "e"}, {1, "a"}, {4, "x"}, {3, "c"}, {1, "y"}};
+  table.insert_range(batch.begin(), batch.end());
+  std::vector<std::string> values(table.values().cbegin(),
+                                  table.values().cend());
+  EXPECT_EQ(values, (std::vector<std::string>{"a", "b", "c", "d", "e"}));
+  std::vector<std::pair<int, std::string>> tail{{9, "i"}, {7, "g"}};
+  table.insert_range(tail.begin(), tail.end());
+  EXPECT_EQ(table.size(), 7U);
+  EXPECT_EQ(table.rbegin()->second, "i");
+}
+
+TEST(FLAT_MAP, SET_ALGEBRA_AND_MERGE) {
+  s21::flat_map<int, int> left{{1, 10}, {2, 20}, {3, 30}, {5, 50}};
+  s21::flat_map<int, int> right{{2, 0}, {3, 0}, {4, 0}, {6, 0}};
+  s21::flat_map<int, int> united = left;
+  united.unite(right);
+  EXPECT_EQ(united.size(), 6U);
+  EXPECT_EQ(united.at(2), 20);
+  s21::flat_map<int, int> common = left;
+  common.intersect(right);
+  EXPECT_EQ(std::vector<int>(common.keys().cbegin(), common.keys().cend()),
+            (std::vector<int>{2, 3}));
+  s21::flat_map<int, int> rest = left;
+  rest.subtract(right);
+  EXPECT_EQ(std::vector<int>(rest.values().cbegin(), rest.values().cend()),
+            (std::vector<int>{10, 50}));
+  left.merge(right);
+  EXPECT_EQ(left.size(), 6U);
+  EXPECT_EQ(std::vector<int>(right.keys().cbegin(), right.keys().cend()),
+            (std::vector<int>{2, 3}));
+}
+
+TEST(FLAT_MAP, TRANSPARENT_LOOKUP) {
+  s21::flat_map<std::string, int, std::less<>> table{{"alpha", 1},
+                                                     {"beta", 2}};
+  EXPECT_EQ(table.find(std::string_view("beta"))->second, 2);
+  EXPECT_TRUE(table.contains(std::string_view("alpha")));
+  EXPECT_FALSE(table.contains(std::string_view("gamma")));
+}
+
+TEST(FLAT_SET, INSERT_RANGE_LOOKUP_AND_ALGEBRA) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dist(0, 200);
+  std::vector<int> items;
+  for (int i = 0; i < 150; ++i) items.push_back(dist(gen));
+  s21::flat_set<int> set(items.begin(), items.end());
+  std::set<int> expected(items.begin(), items.end());
+  ASSERT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+  for (int key = -1; key <= 201; ++key) {
+    EXPECT_EQ(set.contains(key), expected.count(key) == 1U);
+    EXPECT_EQ(set.upper_bound(key) - set.begin(),
+              std::distance(expected.begin(), expected.upper_bound(key)));
+  }
+  std::vector<int> more{500, 300, 5, 400};
+  set.insert_range(more.begin(), more.end());
+  expected.insert(more.begin(), more.end());
+  EXPECT_TRUE(std::equal(set.crbegin(), set.crend(), expected.rbegin(),
+                         expected.rend()));
+  EXPECT_FALSE(set.insert(300).second);
+  EXPECT_EQ(*set.insert(set.end(), 600), 600);
+  EXPECT_EQ(set.erase(600), 1U);
+  s21::flat_set<int> other{5, 300, 1000};
+  s21::flat_set<int> united{1000, 2, 5};
+  united.unite(other);
+  EXPECT_EQ(std::vector<int>(united.begin(), united.end()),
+            (std::vector<int>{2, 5, 300, 1000}));
+  s21::flat_set<int> common = set;
+  common.intersect(other);
+  EXPECT_EQ(std::vector<int>(common.begin(), common.end()),
+            (std::vector<int>{5, 300}));
+  set.subtract(other);
+  EXPECT_FALSE(set.contains(300));
+  set.merge(other);
+  EXPECT_TRUE(set.contains(1000));
+  EXPECT_EQ(std::vector<int>(other.begin(), other.end()),
+            (std::vector<int>{}));
+  EXPECT_EQ(*set.select(set.rank(400)), 400);
+}
+
+TEST(FLAT_SET, THROWING_MERGE_LEAVES_A_VALID_SET) {
+  s21::flat_set<MoveBomb> set{1, 2, 3, 4, 6, 7};
+  // unite copies the new keys, so the first move is in the merge
+  const MoveBomb bomb(5, true);
+  s21::Vector<MoveBomb> keys;
+  keys.push_back(bomb);
+  s21::flat_set<MoveBomb> other(s21::sorted_unique, std::move(keys));
+  EXPECT_THROW(set.unite(other), std::runtime_error);
+  // cleared like flat_map, rather than left with moved-from keys
+  EXPECT_TRUE(set.empty());
+  set.insert(MoveBomb(2));
+  EXPECT_TRUE(set.contains(MoveBomb(2)));
+}
+}  // namespace
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
 
@@ -788,3 +789,65 @@ TEST(LIST, OPERATOR_EQUAL_MOVE) {
   ASSERT_EQ(listsEqual(L1, L3), true);
   ASSERT_EQ(listsEqual(L2, L4), true);
 }
+
+namespace {
+// counts the blocks it hands out, copies sharing a counter compare equal
+template <class T>
+struct CountingListAllocator {
+  using value_type = T;
+
+  explicit CountingListAllocator(int *live_) : live(live_) {}
+  template <class U>
+  CountingListAllocator(const CountingListAllocator<U> &other)
+      : live(other.live) {}
+
+  T *allocate(std::size_t n) {
+    ++*live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    --*live;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <class U>
+  bool operator==(const CountingListAllocator<U> &other) const {
+    return live == other.live;
+  }
+  template <class U>
+  bool operator!=(const CountingListAllocator<U> &other) const {
+    return live != other.live;
+  }
+
+  int *live;
+};
+}  // namespace
+
+TEST(LIST, ALLOCATOR_OWNS_EVERY_NODE) {
+  using Alloc = CountingListAllocator<int>;
+  int live = 0, other_live = 0;
+  {
+    s21::list<int, Alloc> L1{Alloc(&live)};
+    EXPECT_EQ(live, 1);
+    for (int i = 0; i < 5; ++i) L1.push_back(i);
+    EXPECT_EQ(live, 6);
+    s21::list<int, Alloc> L2(L1);
+    EXPECT_EQ(live, 12);
+
+    // unequal allocators: the values are moved into nodes of L3
+    s21::list<int, Alloc> L3{Alloc(&other_live)};
+    L3 = std::move(L1);
+    EXPECT_EQ(other_live, 6);
+    EXPECT_EQ(live, 7);
+    EXPECT_TRUE(L1.empty());
+    EXPECT_EQ(L3.back(), 4);
+
+    // equal allocators: the nodes change hands
+    L1 = std::move(L2);
+    EXPECT_EQ(live, 7);
+    EXPECT_EQ(L1.size(), 5U);
+    L1.pop_front();
+    EXPECT_EQ(live, 6);
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+}
@@ -1,10 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
+#include "../containers/s21_arena_tree.h"
+#include "../containers/s21_bplustree.h"
 #include "../containers/s21_map.h"
 
 namespace {
@@ -785,3 +792,563 @@ TEST(MAP_ITERATORS, MAP_EQUAL_OPERATOR) {
   std::map<int, char> M2 = {{50, 'a'}, {25, 'b'}, {75, 'c'}, {10, 'd'}};
   ASSERT_EQ(M1.begin() == M1.begin(), M2.begin() == M2.begin());
 }
+
+TEST(MAP_METHOD_RESERVE, MAP_RESERVE_INSERT_ERASE_CLEAR) {
+  s21::map<int, std::string> M1;
+  std::map<int, std::string> M2;
+  M1.reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    M1.insert(i * 7 % 100, std::to_string(i));
+    M2.insert({i * 7 % 100, std::to_string(i)});
+  }
+  for (int i = 0; i < 100; i += 2) {
+    M1.erase(M1.find(i));
+    M2.erase(i);
+  }
+  for (int i = 100; i < 150; ++i) {
+    M1.insert(i, std::to_string(i));
+    M2.insert({i, std::to_string(i)});
+  }
+  EXPECT_EQ(M1.size(), M2.size());
+  auto it2 = M2.begin();
+  for (auto it1 = M1.begin(); it1 != M1.end(); ++it1, ++it2) {
+    EXPECT_EQ(*it1, *it2);
+  }
+  EXPECT_EQ((*(--M1.end())).first, (*(--M2.end())).first);
+
+  M1.clear();
+  EXPECT_TRUE(M1.empty());
+  M1.insert(-5, "after clear");
+  M1.insert(5, "after clear");
+  EXPECT_EQ((*M1.begin()).first, -5);
+  EXPECT_EQ((*(--M1.end())).first, 5);
+}
+
+TEST(MAP_METHOD_RESERVE, MAP_ERASE_LAST_KEEPS_BOUNDS) {
+  s21::map<int, int> M1 = {{5, 1}};
+  M1.erase(M1.begin());
+  M1.insert(-3, 1);
+  M1.insert(-7, 1);
+  EXPECT_EQ((*M1.begin()).first, -7);
+  EXPECT_EQ((*(--M1.end())).first, -3);
+}
+
+TEST(MAP_BPLUSTREE_BACKEND, MAP_INSERT_ERASE_MERGE) {
+  using bplus_map =
+      s21::map<std::string, int, std::less<std::string>,
+               std::allocator<std::pair<const std::string, int>>,
+               s21::BPlusTreeBackend>;
+  bplus_map M1;
+  std::map<std::string, int> M2;
+  M1.reserve(3000);
+  for (int i = 0; i < 3000; ++i) {
+    std::string key = std::to_string(i * 7919 % 3000);
+    M1[key] = i;
+    M2[key] = i;
+  }
+  for (int i = 0; i < 3000; i += 3) {
+    std::string key = std::to_string(i);
+    M1.erase(M1.find(key));
+    M2.erase(key);
+  }
+  EXPECT_EQ(M1.size(), M2.size());
+  EXPECT_EQ(M1.at("1"), M2.at("1"));
+  EXPECT_THROW(M1.at("0"), std::out_of_range);
+  auto it2 = M2.begin();
+  for (auto it1 = M1.begin(); it1 != M1.end(); ++it1, ++it2) {
+    EXPECT_EQ(*it1, *it2);
+  }
+  EXPECT_EQ((*(--M1.end())).first, (*(--M2.end())).first);
+
+  bplus_map M3 = {{"0", -1}, {"1", -1}};
+  M3.merge(M1);
+  EXPECT_EQ(M3.size(), M2.size() + 1);
+  EXPECT_EQ(M1.size(), 1U);
+  EXPECT_EQ((*M1.begin()).first, "1");
+  EXPECT_EQ(M3.at("1"), -1);
+}
+
+namespace {
+// counts the blocks it hands out, copies sharing a counter compare equal
+template <class T>
+struct CountingMapAllocator {
+  using value_type = T;
+
+  explicit CountingMapAllocator(int *live_) : live(live_) {}
+  template <class U>
+  CountingMapAllocator(const CountingMapAllocator<U> &other)
+      : live(other.live) {}
+
+  T *allocate(std::size_t n) {
+    ++*live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    --*live;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <class U>
+  bool operator==(const CountingMapAllocator<U> &other) const {
+    return live == other.live;
+  }
+  template <class U>
+  bool operator!=(const CountingMapAllocator<U> &other) const {
+    return live != other.live;
+  }
+
+  int *live;
+};
+}  // namespace
+
+TEST(MAP_ALLOCATOR, NODES_COME_FROM_ALLOCATOR) {
+  using Alloc = CountingMapAllocator<std::pair<const int, std::string>>;
+  int live = 0, other_live = 0;
+  {
+    s21::map<int, std::string, std::less<int>, Alloc> M1{Alloc(&live)};
+    EXPECT_EQ(live, 1);
+    for (int i = 0; i < 100; ++i) M1[i] = std::to_string(i);
+    int blocks = live;
+    // clear keeps the slabs, a refill of the same size allocates nothing
+    M1.clear();
+    EXPECT_EQ(live, blocks);
+    M1.reserve(100);
+    for (int i = 0; i < 100; ++i) M1[i] = std::to_string(i);
+    EXPECT_EQ(live, blocks);
+
+    s21::map<int, std::string, std::less<int>, Alloc> M2{Alloc(&other_live)};
+    M2 = std::move(M1);
+    EXPECT_EQ(live, blocks);
+    EXPECT_GT(other_live, 1);
+    EXPECT_EQ(M2.size(), 100U);
+    EXPECT_EQ(M2.at(42), "42");
+    EXPECT_TRUE(M1.empty());
+
+    s21::map<int, std::string, std::less<int>, Alloc> M3(M2);
+    EXPECT_EQ(M3.get_allocator(), M2.get_allocator());
+    s21::map<int, std::string, std::less<int>, Alloc, s21::BPlusTreeBackend>
+        M4{Alloc(&live)};
+    M4.insert(1, "1");
+    EXPECT_EQ(live, blocks + 1);
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+}
+
+namespace {
+// counts default constructions, which key-only lookups must not do
+struct Heavy {
+  Heavy() { ++constructed; }
+  Heavy(int v) : value(v) {}
+  static int constructed;
+  int value = 0;
+};
+int Heavy::constructed = 0;
+}  // namespace
+
+TEST(MAP_LOOKUP, KEY_ONLY_AND_HETEROGENEOUS) {
+  s21::map<std::string, Heavy, std::less<>> M1 = {{"one", Heavy(1)},
+                                                  {"two", Heavy(2)}};
+  Heavy::constructed = 0;
+  EXPECT_EQ(M1.at("one").value, 1);
+  EXPECT_EQ((*M1.find("two")).second.value, 2);
+  EXPECT_TRUE(M1.contains("two"));
+  EXPECT_FALSE(M1.contains("three"));
+  EXPECT_EQ(M1["two"].value, 2);
+  M1.insert_or_assign("one", Heavy(11));
+  EXPECT_EQ(Heavy::constructed, 0);
+
+  std::string_view view = "one";
+  EXPECT_EQ((*M1.find(view)).second.value, 11);
+  EXPECT_TRUE(M1.contains(std::string_view("two")));
+  const auto& C1 = M1;
+  EXPECT_EQ(C1.find(std::string_view("none")), C1.end());
+
+  s21::map<std::string, int, std::less<>,
+           std::allocator<std::pair<const std::string, int>>,
+           s21::BPlusTreeBackend>
+      M2 = {{"a", 1}, {"b", 2}};
+  EXPECT_EQ((*M2.find(std::string_view("b"))).second, 2);
+  EXPECT_FALSE(M2.contains(std::string_view("c")));
+}
+
+namespace {
+// counts every comparison the tree makes
+struct CountedKey {
+  bool operator<(const CountedKey& other) const {
+    ++comparisons;
+    return value < other.value;
+  }
+  static int comparisons;
+  int value;
+};
+int CountedKey::comparisons = 0;
+}  // namespace
+
+TEST(MAP_SINGLE_DESCENT, SUBSCRIPT_COMPARES_LIKE_ONE_FIND) {
+  s21::map<CountedKey, int> M1;
+  for (int i = 0; i < 1000; ++i) M1[CountedKey{i * 7919 % 1000 * 2}] = i;
+  for (int key : {-1, 1, 999, 2001, 0, 1000}) {
+    CountedKey::comparisons = 0;
+    bool found = M1.find(CountedKey{key}) != M1.end();
+    int find_comparisons = CountedKey::comparisons;
+    CountedKey::comparisons = 0;
+    ++M1[CountedKey{key}];
+    EXPECT_EQ(CountedKey::comparisons, find_comparisons);
+    EXPECT_EQ(M1.contains(CountedKey{key}), true);
+    EXPECT_EQ(found, key % 2 == 0 && key >= 0 && key < 2000);
+  }
+}
+
+TEST(MAP_SINGLE_DESCENT, TRY_EMPLACE_AND_EMPLACE) {
+  s21::map<int, std::string> M1;
+  EXPECT_TRUE(M1.try_emplace(1, 3, 'a').second);
+  EXPECT_EQ(M1.at(1), "aaa");
+  std::string moved = "kept";
+  EXPECT_FALSE(M1.try_emplace(1, std::move(moved)).second);
+  EXPECT_EQ(moved, "kept");
+  EXPECT_EQ(M1.at(1), "aaa");
+
+  EXPECT_TRUE(M1.emplace(2, "b").second);
+  EXPECT_FALSE(M1.emplace(std::make_pair(2, "c")).second);
+  EXPECT_EQ(M1.at(2), "b");
+
+  auto result = M1.insert_or_assign(2, "c");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ((*result.first).second, "c");
+  EXPECT_TRUE(M1.insert_or_assign(3, std::string("d")).second);
+  EXPECT_EQ(M1.size(), 3U);
+
+  s21::map<std::string, std::string, std::less<std::string>,
+           std::allocator<std::pair<const std::string, std::string>>,
+           s21::BPlusTreeBackend>
+      M2;
+  for (int i = 0; i < 500; ++i) {
+    std::string key = std::to_string(i * 31 % 500);
+    EXPECT_TRUE(M2.try_emplace(key, key).second);
+    EXPECT_FALSE(M2.try_emplace(key, "other").second);
+    M2[key] += "!";
+  }
+  EXPECT_EQ(M2.at("42"), "42!");
+  EXPECT_TRUE(M2.emplace("x", "y").second);
+  EXPECT_EQ(M2.size(), 501U);
+}
+
+namespace {
+// three-way comparator that counts both kinds of calls
+struct CountingThreeWay {
+  bool operator()(int left, int right) const {
+    ++less_calls;
+    return left < right;
+  }
+  int compare(int left, int right) const {
+    ++compare_calls;
+    return left < right ? -1 : (right < left ? 1 : 0);
+  }
+  static int less_calls;
+  static int compare_calls;
+};
+int CountingThreeWay::less_calls = 0;
+int CountingThreeWay::compare_calls = 0;
+}  // namespace
+
+TEST(MAP_COMPARE, ONE_THREE_WAY_CALL_PER_LEVEL) {
+  s21::map<int, int, CountingThreeWay> M1;
+  for (int i = 0; i < 1023; ++i) M1[i * 7919 % 1023] = i;
+  CountingThreeWay::less_calls = 0;
+  for (int key : {-1, 0, 511, 1022, 5000}) {
+    CountingThreeWay::compare_calls = 0;
+    bool found = M1.contains(key);
+    EXPECT_EQ(found, key >= 0 && key < 1023);
+    // a red-black tree of 1023 keys is at most 20 levels deep
+    EXPECT_LE(CountingThreeWay::compare_calls, 20);
+  }
+  EXPECT_EQ(CountingThreeWay::less_calls, 0);
+}
+
+TEST(MAP_COMPARE, USER_COMPARE_ORDERS_KEYS) {
+  s21::map<int, char, std::greater<int>> M1 = {{1, 'a'}, {3, 'c'}, {2, 'b'}};
+  std::string order;
+  for (auto it = M1.begin(); it != M1.end(); ++it) order += (*it).second;
+  EXPECT_EQ(order, "cba");
+  EXPECT_EQ(M1.at(2), 'b');
+
+  s21::map<int, char, std::greater<int>,
+           std::allocator<std::pair<const int, char>>, s21::BPlusTreeBackend>
+      M2 = {{1, 'a'}, {3, 'c'}, {2, 'b'}};
+  order.clear();
+  for (auto it = M2.begin(); it != M2.end(); ++it) order += (*it).second;
+  EXPECT_EQ(order, "cba");
+}
+
+TEST(MAP_BULK_BUILD, SORTED_AND_UNSORTED_RANGES) {
+  std::vector<std::pair<int, std::string>> sorted;
+  for (int i = 0; i < 1000; ++i) sorted.emplace_back(i, std::to_string(i));
+  s21::map<int, std::string> M1(s21::sorted_unique, sorted.begin(),
+                                sorted.end());
+  EXPECT_EQ(M1.size(), 1000U);
+  EXPECT_EQ(M1.at(999), "999");
+  M1.erase(M1.find(500));
+  M1[-1] = "-1";
+  EXPECT_EQ((*M1.begin()).second, "-1");
+  EXPECT_EQ(M1.size(), 1000U);
+
+  std::vector<std::pair<std::string, int>> unsorted = {
+      {"b", 1}, {"a", 2}, {"c", 3}, {"a", 4}};
+  s21::map<std::string, int> M2(unsorted.begin(), unsorted.end());
+  EXPECT_EQ(M2.size(), 3U);
+  EXPECT_EQ(M2.at("a"), 2);
+
+  s21::map<std::string, int, std::less<std::string>,
+           std::allocator<std::pair<const std::string, int>>,
+           s21::BPlusTreeBackend>
+      M3 = {{"z", 0}};
+  M3.assign(M2.begin(), M2.end());
+  EXPECT_EQ(M3.size(), 3U);
+  EXPECT_FALSE(M3.contains("z"));
+  EXPECT_EQ(M3.at("c"), 3);
+}
+
+TEST(MAP_HINTED_INSERT, APPEND_AT_END_SKIPS_DESCENT) {
+  s21::map<CountedKey, int> M1;
+  M1.insert(M1.end(), {CountedKey{0}, 0});
+  CountedKey::comparisons = 0;
+  for (int i = 1; i < 1000; ++i) {
+    M1.emplace_hint(M1.end(), CountedKey{i}, i);
+  }
+  // one comparison with the cached maximum per append
+  EXPECT_EQ(CountedKey::comparisons, 999);
+  EXPECT_EQ(M1.size(), 1000U);
+  EXPECT_EQ((*--M1.end()).second, 999);
+
+  // a hint in the middle, a wrong hint and an existing key
+  auto it = M1.insert(M1.find(CountedKey{10}), {CountedKey{-5}, -5});
+  EXPECT_EQ((*it).second, -5);
+  EXPECT_EQ(it, M1.begin());
+  it = M1.insert(M1.end(), {CountedKey{500}, 0});
+  EXPECT_EQ((*it).second, 500);
+  EXPECT_EQ(M1.size(), 1001U);
+
+  s21::map<int, int, std::less<int>, std::allocator<std::pair<const int, int>>,
+           s21::BPlusTreeBackend>
+      M2;
+  for (int i = 0; i < 5000; ++i) M2.insert(M2.end(), {i * 2, i});
+  for (int i = 0; i < 5000; i += 7) {
+    M2.emplace_hint(M2.find(i * 2), i * 2 - 1, -i);
+  }
+  EXPECT_EQ(M2.size(), 5000U + 715U);
+  int prev = -10;
+  for (auto item = M2.begin(); item != M2.end(); ++item) {
+    EXPECT_LT(prev, (*item).first);
+    prev = (*item).first;
+  }
+  EXPECT_EQ(M2.at(13), -7);
+}
+
+template <class MapType>
+void CheckBoundsAgainstStd() {
+  MapType M1;
+  std::map<int, int> M2;
+  for (int i = 0; i < 3000; ++i) {
+    int key = i * 7919 % 6000;
+    M1.insert({key, i});
+    M2.insert({key, i});
+  }
+  const MapType& C1 = M1;
+  for (int key = -3; key < 6003; key += 1) {
+    auto lower = M2.lower_bound(key);
+    auto upper = M2.upper_bound(key);
+    if (lower == M2.end()) {
+      EXPECT_EQ(M1.lower_bound(key), M1.end());
+    } else {
+      EXPECT_EQ((*M1.lower_bound(key)).first, lower->first);
+      EXPECT_EQ((*C1.lower_bound(key)).first, lower->first);
+    }
+    if (upper == M2.end()) {
+      EXPECT_EQ(M1.upper_bound(key), M1.end());
+    } else {
+      EXPECT_EQ((*M1.upper_bound(key)).first, upper->first);
+    }
+    auto range = M1.equal_range(key);
+    EXPECT_EQ(range.first == range.second, M2.count(key) == 0);
+  }
+
+  std::size_t scanned = 0;
+  for (const auto& item : M1.range(1000, 1100)) {
+    EXPECT_GE(item.first, 1000);
+    EXPECT_LT(item.first, 1100);
+    ++scanned;
+  }
+  EXPECT_EQ(scanned, static_cast<std::size_t>(std::distance(
+                         M2.lower_bound(1000), M2.lower_bound(1100))));
+  EXPECT_TRUE(C1.range(50, 50).empty());
+  EXPECT_TRUE(M1.range(7000, 8000).empty());
+  MapType empty;
+  EXPECT_TRUE(empty.range(1, 2).empty());
+  EXPECT_EQ(empty.lower_bound(1), empty.end());
+  EXPECT_EQ(empty.equal_range(1).first, empty.end());
+}
+
+TEST(MAP_BOUNDS, LOWER_UPPER_EQUAL_RANGE_AND_SCAN) {
+  CheckBoundsAgainstStd<s21::map<int, int>>();
+  CheckBoundsAgainstStd<
+      s21::map<int, int, std::less<int>,
+               std::allocator<std::pair<const int, int>>,
+               s21::BPlusTreeBackend>>();
+  CheckBoundsAgainstStd<
+      s21::map<int, int, std::less<int>,
+               std::allocator<std::pair<const int, int>>,
+               s21::ArenaTreeBackend>>();
+}
+
+template <class MapType>
+void CheckNodeHandles() {
+  MapType M1, M2;
+  for (int i = 0; i < 100; ++i) M1[i] = std::vector<int>(100, i);
+  const int* data = M1.at(42).data();
+  typename MapType::node_type node = M1.extract(42);
+  EXPECT_FALSE(node.empty());
+  EXPECT_EQ(M1.size(), 99U);
+  EXPECT_FALSE(M1.contains(42));
+
+  // the mapped vector moves along, its buffer is never copied
+  node.key() = 1000;
+  typename MapType::insert_return_type result = M2.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_TRUE(node.empty());
+  EXPECT_EQ((*result.position).first, 1000);
+  EXPECT_EQ(M2.at(1000).data(), data);
+
+  node = M1.extract(M1.find(7));
+  node.key() = -7;
+  auto it = M1.insert(M1.begin(), std::move(node));
+  EXPECT_EQ(it, M1.begin());
+  EXPECT_EQ((*it).second[0], 7);
+
+  // an existing key gives the handle back, a missing one an empty handle
+  node = M2.extract(1000);
+  node.key() = 10;
+  result = M1.insert(std::move(node));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ((*result.position).second[0], 10);
+  EXPECT_EQ(result.node.key(), 10);
+  EXPECT_EQ(result.node.mapped().data(), data);
+  EXPECT_TRUE(M2.empty());
+  EXPECT_TRUE(M1.extract(12345).empty());
+  EXPECT_FALSE(M1.insert(typename MapType::node_type()).inserted);
+  EXPECT_EQ(M1.size(), 99U);
+}
+
+TEST(MAP_NODE_HANDLE, EXTRACT_REKEY_AND_MOVE_BETWEEN_MAPS) {
+  CheckNodeHandles<s21::map<int, std::vector<int>>>();
+  CheckNodeHandles<s21::map<
+      int, std::vector<int>, std::less<int>,
+      std::allocator<std::pair<const int, std::vector<int>>>,
+      s21::BPlusTreeBackend>>();
+  CheckNodeHandles<s21::map<
+      int, std::vector<int>, std::less<int>,
+      std::allocator<std::pair<const int, std::vector<int>>>,
+      s21::ArenaTreeBackend>>();
+
+  // rekeying in place reuses the node the extract freed
+  s21::map<int, std::string> M1 = {{1, "one"}, {2, "two"}, {3, "three"}};
+  const auto* address = &*M1.find(2);
+  auto node = M1.extract(2);
+  node.key() = 4;
+  auto it = M1.insert(std::move(node)).position;
+  EXPECT_EQ(&*it, address);
+  EXPECT_EQ(M1.at(4), "two");
+}
+
+// orders by a runtime flag, so a default-constructed copy orders differently
+struct FlaggedOrder {
+  bool descending = false;
+  bool operator()(int left, int right) const {
+    return descending ? right < left : left < right;
+  }
+};
+
+TEST(MAP_BPLUSTREE, MERGE_KEEPS_COMPARATOR_AND_DUPLICATES) {
+  using bplus_map =
+      s21::map<int, std::string, FlaggedOrder,
+               std::allocator<std::pair<const int, std::string>>,
+               s21::BPlusTreeBackend>;
+  bplus_map M1(FlaggedOrder{true});
+  bplus_map M2(FlaggedOrder{true});
+  for (int i = 0; i < 300; ++i) M1[i] = std::string(30, 'a');
+  for (int i = 200; i < 500; ++i) M2[i] = std::string(30, 'b');
+  M1.merge(M2);
+  EXPECT_EQ(M1.size(), 500U);
+  EXPECT_EQ((*M1.begin()).first, 499);
+  ASSERT_EQ(M2.size(), 100U);
+  int expected = 299;
+  for (const auto& item : M2) {
+    EXPECT_EQ(item.first, expected--);
+    EXPECT_EQ(item.second, std::string(30, 'b'));
+  }
+  M2[1000] = "c";
+  EXPECT_EQ((*M2.begin()).first, 1000);
+}
+
+TEST(MAP_BPLUSTREE, LEAF_SHIFTS_MOVE_KEYS) {
+  s21::map<std::string, int, std::less<std::string>,
+           std::allocator<std::pair<const std::string, int>>,
+           s21::BPlusTreeBackend>
+      M1;
+  auto key = [](int i) { return std::string(50, 'k') + std::to_string(i); };
+  for (int i = 0; i < 1000; i += 2) M1[key(i)] = i;
+  std::vector<const char*> buffers;
+  for (int i = 0; i < 1000; i += 2) {
+    buffers.push_back((*M1.find(key(i))).first.data());
+  }
+
+  // shifts, splits, borrows and merges keep every key buffer in place
+  for (int i = 1; i < 1000; i += 2) M1[key(i)] = i;
+  for (int i = 1; i < 1000; i += 2) M1.erase(M1.find(key(i)));
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_EQ((*M1.find(key(i))).first.data(), buffers[i / 2]);
+  }
+}
+
+template <class Backend>
+void CheckExtractMovesKey() {
+  s21::map<std::string, int, std::less<std::string>,
+           std::allocator<std::pair<const std::string, int>>, Backend>
+      M1;
+  for (int i = 0; i < 100; ++i) M1[std::string(40, 'a') + std::to_string(i)];
+  std::string key = std::string(40, 'a') + "42";
+  const char* buffer = (*M1.find(key)).first.data();
+  auto node = M1.extract(key);
+  EXPECT_EQ(node.key().data(), buffer);
+  EXPECT_EQ(node.key(), key);
+  auto result = M1.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ((*result.position).first.data(), buffer);
+}
+
+TEST(MAP_NODE_HANDLE, EXTRACT_MOVES_THE_KEY) {
+  CheckExtractMovesKey<s21::RedBlackTreeBackend>();
+  CheckExtractMovesKey<s21::BPlusTreeBackend>();
+  CheckExtractMovesKey<s21::ArenaTreeBackend>();
+}
+
+TEST(MAP_ITERATORS, REVERSE_ITERATION) {
+  s21::map<int, int> M1;
+  s21::map<int, int, std::less<int>, std::allocator<std::pair<const int, int>>,
+           s21::BPlusTreeBackend>
+      M2;
+  EXPECT_EQ(M1.rbegin(), M1.rend());
+  for (int i = 0; i < 500; ++i) {
+    M1[i * 3 % 500] = i;
+    M2[i * 3 % 500] = i;
+  }
+  int expected = 499;
+  for (auto it = M1.rbegin(); it != M1.rend(); ++it) {
+    EXPECT_EQ((*it).first, expected--);
+  }
+  EXPECT_EQ(expected, -1);
+  EXPECT_TRUE(std::equal(M1.rbegin(), M1.rend(), M2.rbegin(), M2.rend()));
+  const auto& C1 = M1;
+  EXPECT_EQ((*C1.rbegin()).first, 499);
+  EXPECT_EQ((*--C1.rend()).first, 0);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../containers/s21_memory_resource.h"
+
+TEST(MemoryResource, Counting_Measures_Container) {
+  s21::CountingResource counter;
+  {
+    s21::pmr::map<int, int> m(&counter);
+    for (int i = 0; i < 1000; ++i) m[i] = i;
+    s21::ResourceStats stats = counter.stats();
+    EXPECT_GT(stats.bytes_in_use, 1000 * 2 * sizeof(int));
+    EXPECT_EQ(stats.deallocations, 0U);
+    EXPECT_EQ(stats.peak_bytes, stats.bytes_in_use);
+  }
+  s21::ResourceStats stats = counter.stats();
+  EXPECT_EQ(stats.bytes_in_use, 0U);
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_GT(stats.peak_bytes, 0U);
+}
+
+TEST(MemoryResource, Monotonic_Uses_Buffer_First) {
+  s21::CountingResource upstream;
+  alignas(std::max_align_t) unsigned char buffer[256];
+  s21::MonotonicBufferResource monotonic(buffer, sizeof(buffer), &upstream);
+
+  void* first = monotonic.allocate(10, 1);
+  void* second = monotonic.allocate(16, 16);
+  EXPECT_EQ(first, buffer);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 16, 0U);
+  EXPECT_EQ(upstream.stats().allocations, 0U);
+
+  void* big = monotonic.allocate(1000, 64);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 64, 0U);
+  EXPECT_EQ(upstream.stats().allocations, 1U);
+
+  // memory is never reused before release()
+  monotonic.deallocate(second, 16, 16);
+  EXPECT_NE(monotonic.allocate(16, 16), second);
+  EXPECT_EQ(monotonic.stats().bytes_in_use, 10U + 1000U + 16U);
+  EXPECT_EQ(monotonic.stats().deallocations, 1U);
+
+  monotonic.release();
+  EXPECT_EQ(upstream.stats().bytes_in_use, 0U);
+  EXPECT_EQ(monotonic.allocate(10, 1), buffer);
+}
+
+TEST(MemoryResource, Monotonic_Backs_Containers) {
+  s21::MonotonicBufferResource monotonic;
+  s21::pmr::list<std::string> l(&monotonic);
+  s21::pmr::Vector<int> v(&monotonic);
+  for (int i = 0; i < 500; ++i) {
+    l.push_back(std::to_string(i));
+    v.push_back(i);
+  }
+  EXPECT_EQ(l.back(), "499");
+  EXPECT_EQ(v[499], 499);
+  EXPECT_EQ(l.get_allocator().resource(), &monotonic);
+}
+
+TEST(MemoryResource, Pool_Reuses_Blocks) {
+  s21::CountingResource upstream;
+  s21::PoolResource pool(&upstream);
+
+  void* block = pool.allocate(24, 8);
+  std::size_t chunks = upstream.stats().allocations;
+  EXPECT_EQ(chunks, 1U);
+  pool.deallocate(block, 24, 8);
+  EXPECT_EQ(pool.allocate(20, 4), block);
+  EXPECT_EQ(upstream.stats().allocations, chunks);
+
+  void* big = pool.allocate(s21::PoolResource::kMaxBlockBytes + 1, 8);
+  EXPECT_EQ(upstream.stats().allocations, chunks + 1);
+  pool.deallocate(big, s21::PoolResource::kMaxBlockBytes + 1, 8);
+  EXPECT_EQ(pool.stats().bytes_in_use, 20U);
+
+  void* aligned = pool.allocate(64, 64);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0U);
+  pool.deallocate(aligned, 64, 64);
+
+  pool.release();
+  EXPECT_EQ(upstream.stats().bytes_in_use, 0U);
+}
+
+TEST(MemoryResource, Pool_Backs_Containers) {
+  s21::PoolResource pool;
+  {
+    s21::pmr::Set<int> s({5, 3, 8}, &pool);
+    s21::pmr::Stack<int> st(&pool);
+    s21::pmr::Queue<int> q(&pool);
+    for (int i = 0; i < 100; ++i) {
+      s.insert(i);
+      st.push(i);
+      q.push(i);
+    }
+    EXPECT_EQ(s.size(), 100U);
+    EXPECT_EQ(st.top(), 99);
+    EXPECT_EQ(q.front(), 0);
+  }
+  EXPECT_EQ(pool.stats().bytes_in_use, 0U);
+}
+
+TEST(MemoryResource, Thread_Local_Pool) {
+  s21::ThreadLocalPoolResource resource;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&resource, t] {
+      s21::pmr::list<int> l(&resource);
+      for (int i = 0; i < 10000; ++i) {
+        l.push_back(i * t);
+        if (i % 3 == 0) l.pop_front();
+      }
+      s21::pmr::map<int, int> m(&resource);
+      for (int i = 0; i < 1000; ++i) m[i] = t;
+      EXPECT_EQ(m.at(999), t);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  // caches of the finished threads went back with their counters
+  s21::ResourceStats stats = resource.stats();
+  EXPECT_EQ(stats.bytes_in_use, 0U);
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_GT(stats.allocations, 4U * 10000U);
+
+  s21::pmr::Vector<int> v(&resource);
+  v.push_back(1);
+  EXPECT_GT(resource.stats().bytes_in_use, 0U);
+}
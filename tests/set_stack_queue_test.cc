@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <queue>
 #include <set>
 #include <stack>
+#include <string>
+#include <vector>
 
+#include "../containers/s21_arena_tree.h"
+#include "../containers/s21_bplustree.h"
 #include "../containers/s21_queue.h"
 #include "../containers/s21_set.h"
 #include "../containers/s21_stack.h"
@@ -366,3 +373,626 @@ TEST(Set, Bool_Contains) {
   EXPECT_EQ(x.contains(3), y.find(3) != y.end());
   EXPECT_EQ(x.contains(2), y.find(2) != y.end());
 }
+
+TEST(Set, Reserve_Clear_Reinsert) {
+  s21::Set<std::string> x;
+  std::set<std::string> y;
+  x.reserve(64);
+  for (int i = 0; i < 64; ++i) {
+    x.insert(std::to_string(i));
+    y.insert(std::to_string(i));
+  }
+  x.erase(x.find("10"));
+  y.erase("10");
+  x.insert("10a");
+  y.insert("10a");
+  EXPECT_EQ(x.size(), y.size());
+  auto y_it = y.begin();
+  for (auto x_it = x.begin(); x_it != x.end(); ++x_it, ++y_it) {
+    EXPECT_EQ(*x_it, *y_it);
+  }
+  x.clear();
+  EXPECT_EQ(x.empty(), true);
+  x.insert("z");
+  x.insert("a");
+  EXPECT_EQ(*x.begin(), "a");
+  EXPECT_EQ(*(--x.end()), "z");
+
+  // slabs kept by clear move along when another set merges this one
+  s21::Set<std::string> merged = {"m"};
+  merged.merge(x);
+  EXPECT_TRUE(x.empty());
+  for (int i = 0; i < 200; ++i) merged.insert(std::to_string(i));
+  EXPECT_EQ(merged.size(), 203U);
+  for (int i = 0; i < 200; ++i) x.insert(std::to_string(i));
+  EXPECT_EQ(x.size(), 200U);
+}
+
+TEST(Set, Random_Insert_Erase) {
+  s21::Set<int> x;
+  std::set<int> y;
+  unsigned seed = 12345;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 500);
+    if ((seed >> 4) & 1U) {
+      EXPECT_EQ(x.insert(key).second, y.insert(key).second);
+    } else if (x.contains(key)) {
+      x.erase(x.find(key));
+      y.erase(key);
+    }
+  }
+  EXPECT_EQ(x.size(), y.size());
+  auto y_it = y.begin();
+  for (auto x_it = x.begin(); x_it != x.end(); ++x_it, ++y_it) {
+    EXPECT_EQ(*x_it, *y_it);
+  }
+  EXPECT_EQ(*(--x.end()), *(--y.end()));
+}
+
+TEST(Set, BPlusTree_Random_Insert_Erase) {
+  s21::Set<int, std::less<int>, std::allocator<int>,
+           s21::BPlusTreeBackend> x;
+  std::set<int> y;
+  unsigned seed = 54321;
+  x.reserve(20000);
+  for (int step = 0; step < 50000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 20000);
+    if ((seed >> 4) % 3 != 0) {
+      EXPECT_EQ(x.insert(key).second, y.insert(key).second);
+    } else if (x.contains(key)) {
+      x.erase(x.find(key));
+      y.erase(key);
+    }
+  }
+  EXPECT_EQ(x.size(), y.size());
+  auto y_it = y.begin();
+  for (auto x_it = x.begin(); x_it != x.end(); ++x_it, ++y_it) {
+    EXPECT_EQ(*x_it, *y_it);
+  }
+  auto y_rit = y.rbegin();
+  for (auto x_it = x.end(); x_it != x.begin(); ++y_rit) {
+    EXPECT_EQ(*--x_it, *y_rit);
+  }
+  s21::Set<int, std::less<int>, std::allocator<int>,
+           s21::BPlusTreeBackend> copy(x);
+  EXPECT_EQ(copy.size(), x.size());
+  while (!x.empty()) x.erase(x.begin());
+  EXPECT_EQ(x.begin(), x.end());
+}
+
+TEST(Set, Order_Statistics) {
+  using OrderedSet = s21::Set<int, std::less<int>, std::allocator<int>,
+                              s21::OrderStatisticTreeBackend>;
+  OrderedSet x;
+  std::set<int> y;
+  unsigned seed = 777;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 5000);
+    if ((seed >> 4) % 3 != 0) {
+      x.insert(key);
+      y.insert(key);
+    } else if (x.contains(key)) {
+      x.erase(x.find(key));
+      y.erase(key);
+    }
+    if (step % 1000 == 0) {
+      auto y_it = y.lower_bound(key);
+      std::size_t rank = std::distance(y.begin(), y_it);
+      EXPECT_EQ(x.rank(key), rank);
+      if (y_it != y.end()) {
+        EXPECT_EQ(*x.select(rank), *y_it);
+      }
+    }
+  }
+  ASSERT_EQ(x.size(), y.size());
+  std::size_t index = 0;
+  for (int key : y) {
+    EXPECT_EQ(x.rank(key), index);
+    EXPECT_EQ(*x.select(index), key);
+    ++index;
+  }
+  EXPECT_EQ(x.select(x.size()), x.end());
+  EXPECT_EQ(x.rank(5000), x.size());
+
+  OrderedSet copy(x);
+  auto it = copy.begin() + 10;
+  EXPECT_EQ(*it, *std::next(y.begin(), 10));
+  EXPECT_EQ(*(it - 7), *std::next(y.begin(), 3));
+  EXPECT_EQ(copy.end() - 1, --copy.end());
+  EXPECT_EQ(it + (copy.size() - 10), copy.end());
+  it += 5;
+  EXPECT_EQ(copy.rank(*it), 15U);
+
+  OrderedSet empty;
+  EXPECT_EQ(empty.select(0), empty.end());
+  EXPECT_EQ(empty.rank(1), 0U);
+}
+
+template <class SetType>
+void CheckBuiltFromSortedRange() {
+  std::vector<int> sorted;
+  for (int i = 0; i < 3000; ++i) sorted.push_back(i * 2);
+  for (std::size_t n : {0U, 1U, 2U, 3U, 7U, 8U, 100U, 3000U}) {
+    SetType x(s21::sorted_unique, sorted.begin(), sorted.begin() + n);
+    std::set<int> y(sorted.begin(), sorted.begin() + n);
+    ASSERT_EQ(x.size(), n);
+    // the built tree has to stay valid under later inserts and erases
+    for (int key = 1; key < 400; key += 3) {
+      EXPECT_EQ(x.insert(key).second, y.insert(key).second);
+    }
+    for (int key = 0; key < 6000; key += 5) {
+      if (x.contains(key)) {
+        x.erase(x.find(key));
+        y.erase(key);
+      }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    auto y_it = y.begin();
+    for (auto x_it = x.begin(); x_it != x.end(); ++x_it, ++y_it) {
+      EXPECT_EQ(*x_it, *y_it);
+    }
+  }
+}
+
+TEST(Set, Build_From_Sorted_Range) {
+  CheckBuiltFromSortedRange<s21::Set<int>>();
+  CheckBuiltFromSortedRange<s21::Set<int, std::less<int>, std::allocator<int>,
+                                     s21::OrderStatisticTreeBackend>>();
+  CheckBuiltFromSortedRange<s21::Set<int, std::less<int>, std::allocator<int>,
+                                     s21::BPlusTreeBackend>>();
+
+  int odd[] = {1, 3, 5, 7, 9};
+  s21::Set<int, std::less<int>, std::allocator<int>,
+           s21::OrderStatisticTreeBackend>
+      ranked(s21::sorted_unique, std::begin(odd), std::end(odd));
+  EXPECT_EQ(ranked.rank(6), 3U);
+  EXPECT_EQ(*ranked.select(4), 9);
+}
+
+TEST(Set, Build_From_Unsorted_Range) {
+  std::vector<std::string> words = {"pear", "apple", "fig", "apple", "kiwi"};
+  s21::Set<std::string> x(words.begin(), words.end());
+  EXPECT_EQ(x.size(), 4U);
+  EXPECT_EQ(*x.begin(), "apple");
+  EXPECT_EQ(*--x.end(), "pear");
+
+  s21::Set<int, std::greater<int>, std::allocator<int>,
+           s21::BPlusTreeBackend>
+      y;
+  std::vector<int> numbers;
+  for (int i = 0; i < 5000; ++i) numbers.push_back(i * 7919 % 5000);
+  y.insert(-1);
+  y.assign(numbers.begin(), numbers.end());
+  EXPECT_EQ(y.size(), 5000U);
+  EXPECT_FALSE(y.contains(-1));
+  EXPECT_EQ(*y.begin(), 4999);
+}
+
+template <class SetType>
+void CheckHintedInsert() {
+  SetType x;
+  std::set<int> y;
+  unsigned seed = 2024;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 8000);
+    // right, wrong and end() hints alike
+    auto hint = step % 3 == 0 ? x.end() : x.find(key + 1);
+    if (hint == x.end() && step % 3 != 0) hint = x.find(key + 2);
+    auto it = x.insert(hint, key);
+    y.insert(key);
+    EXPECT_EQ(*it, key);
+  }
+  for (int key = 10000; key < 12000; ++key) x.emplace_hint(x.end(), key);
+  y.insert(x.find(10000), x.end());
+  ASSERT_EQ(x.size(), y.size());
+  auto y_it = y.begin();
+  for (auto x_it = x.begin(); x_it != x.end(); ++x_it, ++y_it) {
+    EXPECT_EQ(*x_it, *y_it);
+  }
+}
+
+TEST(Set, Hinted_Insert) {
+  CheckHintedInsert<s21::Set<int>>();
+  CheckHintedInsert<s21::Set<int, std::less<int>, std::allocator<int>,
+                             s21::OrderStatisticTreeBackend>>();
+  CheckHintedInsert<s21::Set<int, std::less<int>, std::allocator<int>,
+                             s21::BPlusTreeBackend>>();
+
+  s21::Set<int, std::less<int>, std::allocator<int>,
+           s21::OrderStatisticTreeBackend>
+      ranked;
+  for (int i = 99; i >= 0; --i) ranked.insert(ranked.begin(), i);
+  EXPECT_EQ(ranked.rank(50), 50U);
+  EXPECT_EQ(*ranked.select(99), 99);
+}
+
+TEST(Set, Bounds_And_Range) {
+  s21::Set<int> x = {10, 20, 30, 40};
+  EXPECT_EQ(*x.lower_bound(20), 20);
+  EXPECT_EQ(*x.upper_bound(20), 30);
+  EXPECT_EQ(*x.lower_bound(21), 30);
+  EXPECT_EQ(x.upper_bound(40), x.end());
+  auto equal = x.equal_range(30);
+  EXPECT_EQ(*equal.first, 30);
+  EXPECT_EQ(*equal.second, 40);
+  equal = x.equal_range(35);
+  EXPECT_EQ(equal.first, equal.second);
+  int sum = 0;
+  for (int key : x.range(15, 40)) sum += key;
+  EXPECT_EQ(sum, 50);
+  EXPECT_TRUE(x.range(40, 15).empty());
+}
+
+TEST(Set, Threaded_Iteration) {
+  using ThreadedSet = s21::Set<int, std::less<int>, std::allocator<int>,
+                               s21::ThreadedTreeBackend>;
+  ThreadedSet x;
+  std::set<int> expected;
+  EXPECT_EQ(x.begin(), x.end());
+  EXPECT_EQ(x.rbegin(), x.rend());
+  unsigned seed = 7;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 5000);
+    if (seed & 0x10000) {
+      x.insert(key);
+      expected.insert(key);
+    } else if (x.contains(key)) {
+      x.erase(x.find(key));
+      expected.erase(key);
+    }
+  }
+  EXPECT_TRUE(std::equal(x.begin(), x.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), expected.rbegin(),
+                         expected.rend()));
+  EXPECT_EQ(*--x.end(), *expected.rbegin());
+
+  ThreadedSet copy(x);
+  ThreadedSet built(expected.begin(), expected.end());
+  EXPECT_TRUE(std::equal(copy.crbegin(), copy.crend(), expected.rbegin(),
+                         expected.rend()));
+  EXPECT_TRUE(std::equal(built.begin(), built.end(), expected.begin(),
+                         expected.end()));
+  built.insert(-1);
+  built.insert(9999);
+  EXPECT_EQ(*built.begin(), -1);
+  EXPECT_EQ(*built.rbegin(), 9999);
+  EXPECT_EQ(*++built.begin(), *expected.begin());
+}
+
+template <class Key, class Backend>
+constexpr std::size_t kSetNodeSize = sizeof(
+    typename s21::Set<Key, std::less<Key>, std::allocator<Key>,
+                      Backend>::tree_type::node_type);
+
+// word-sized keys lose the flag word, 4-byte keys only shrink in the arena
+static_assert(kSetNodeSize<long, s21::CompactTreeBackend> ==
+              3 * sizeof(void *) + sizeof(long));
+static_assert(kSetNodeSize<long, s21::CompactTreeBackend> <
+              kSetNodeSize<long, s21::RedBlackTreeBackend>);
+static_assert(kSetNodeSize<std::string, s21::CompactTreeBackend> <
+              kSetNodeSize<std::string, s21::RedBlackTreeBackend>);
+static_assert(kSetNodeSize<int, s21::CompactTreeBackend> ==
+              kSetNodeSize<int, s21::RedBlackTreeBackend>);
+static_assert(kSetNodeSize<int, s21::ArenaTreeBackend> == 16);
+
+TEST(Set, Compact_Nodes) {
+  using CompactSet = s21::Set<long, std::less<long>, std::allocator<long>,
+                              s21::CompactTreeBackend>;
+
+  CompactSet x;
+  std::set<long> expected;
+  unsigned seed = 3;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    long key = static_cast<long>((seed >> 8) % 4000);
+    if (seed & 0x10000) {
+      x.insert(key);
+      expected.insert(key);
+    } else if (x.contains(key)) {
+      x.erase(x.find(key));
+      expected.erase(key);
+    }
+  }
+  EXPECT_EQ(x.size(), expected.size());
+  EXPECT_TRUE(std::equal(x.begin(), x.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), expected.rbegin(),
+                         expected.rend()));
+  CompactSet copy(x);
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(Set, Arena_Tree) {
+  using ArenaSet = s21::Set<int, std::less<int>, std::allocator<int>,
+                            s21::ArenaTreeBackend>;
+  EXPECT_EQ(sizeof(ArenaSet::tree_type::node_type), 16U);
+
+  ArenaSet x;
+  std::set<int> expected;
+  x.insert(-1);
+  auto first = x.begin();
+  unsigned seed = 11;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 5000);
+    if (seed & 0x10000) {
+      x.insert(key);
+      expected.insert(key);
+    } else if (x.contains(key)) {
+      x.erase(x.find(key));
+      expected.erase(key);
+    }
+  }
+  // iterators are indices, the arena grew under this one
+  EXPECT_EQ(*first, -1);
+  x.erase(first);
+  EXPECT_EQ(x.size(), expected.size());
+  EXPECT_TRUE(std::equal(x.begin(), x.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), expected.rbegin(),
+                         expected.rend()));
+
+  // a copy takes the slots as they are, a bulk build lays them in order
+  ArenaSet copy(x);
+  ArenaSet built(expected.begin(), expected.end());
+  x.clear();
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(built.begin(), built.end(), expected.begin(),
+                         expected.end()));
+  built.insert(built.end(), 10000);
+  EXPECT_EQ(*built.rbegin(), 10000);
+
+  s21::Set<std::string, std::less<std::string>,
+           std::allocator<std::string>, s21::ArenaTreeBackend>
+      words = {"pear", "apple", "fig"};
+  words.insert(*words.begin() + "s");
+  auto copy_words = words;
+  EXPECT_EQ(*copy_words.begin(), "apple");
+  EXPECT_EQ(*++copy_words.begin(), "apples");
+  EXPECT_EQ(copy_words.size(), 4U);
+}
+
+TEST(Set, Arena_Tree_Iterators_Stay_With_The_Tree_Object) {
+  using ArenaSet = s21::Set<int, std::less<int>, std::allocator<int>,
+                            s21::ArenaTreeBackend>;
+  // same insertion order, same slots
+  ArenaSet a = {1, 2, 3};
+  ArenaSet b = {10, 20, 30};
+  auto it = a.find(2);
+  a.swap(b);
+  // the iterator indexes a, which now holds the values of b
+  EXPECT_EQ(*it, 20);
+  EXPECT_EQ(*b.find(2), 2);
+  EXPECT_EQ(*++b.find(2), 3);
+  ArenaSet moved(std::move(b));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(*moved.find(3), 3);
+}
+
+TEST(Set, Node_Handle) {
+  std::string long_key(100, 'a');
+  s21::Set<std::string> x = {"b", long_key, "c"};
+  const char *data = (*x.find(long_key)).data();
+  s21::Set<std::string>::node_type node = x.extract(long_key);
+  EXPECT_EQ(x.size(), 2U);
+  EXPECT_EQ(node.value().data(), data);
+  node.value()[0] = 'z';
+
+  s21::Set<std::string> y;
+  auto result = y.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(node.empty());
+  EXPECT_EQ((*result.position).data(), data);
+  EXPECT_EQ((*result.position)[0], 'z');
+
+  node = x.extract(x.find("b"));
+  node.value() = "c";
+  result = x.insert(std::move(node));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.node.value(), "c");
+  EXPECT_TRUE(x.extract("missing").empty());
+
+  s21::Set<int, std::less<int>, std::allocator<int>, s21::BPlusTreeBackend> z;
+  for (int i = 0; i < 1000; ++i) z.insert(i);
+  for (int i = 0; i < 1000; i += 2) {
+    auto handle = z.extract(i);
+    handle.value() = -i - 1;
+    z.insert(z.begin(), std::move(handle));
+  }
+  EXPECT_EQ(z.size(), 1000U);
+  EXPECT_EQ(*z.begin(), -999);
+  EXPECT_TRUE(z.contains(-1));
+  EXPECT_FALSE(z.contains(0));
+}
+
+template <class SetType>
+void CheckSetAlgebra(int size) {
+  SetType x, y;
+  std::set<int> sx, sy;
+  unsigned seed = 99;
+  for (int i = 0; i < size; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % (3 * size));
+    x.insert(key);
+    sx.insert(key);
+    key = static_cast<int>((seed >> 4) % (3 * size));
+    y.insert(key);
+    sy.insert(key);
+  }
+  std::set<int> united = sx, common, rest, duplicates;
+  for (int key : sy) {
+    if (!united.insert(key).second) duplicates.insert(key);
+  }
+  for (int key : sx) (sy.count(key) ? common : rest).insert(key);
+
+  SetType copy_x(x), copy_y(y);
+  copy_x.merge(copy_y);
+  EXPECT_TRUE(std::equal(copy_x.begin(), copy_x.end(), united.begin(),
+                         united.end()));
+  EXPECT_TRUE(std::equal(copy_y.begin(), copy_y.end(), duplicates.begin(),
+                         duplicates.end()));
+  copy_x = x;
+  copy_x.unite(y);
+  EXPECT_TRUE(std::equal(copy_x.begin(), copy_x.end(), united.begin(),
+                         united.end()));
+  copy_x = x;
+  copy_x.intersect(y);
+  EXPECT_TRUE(std::equal(copy_x.begin(), copy_x.end(), common.begin(),
+                         common.end()));
+  EXPECT_EQ(copy_x.size(), common.size());
+  x.subtract(y);
+  EXPECT_TRUE(std::equal(x.begin(), x.end(), rest.begin(), rest.end()));
+  EXPECT_EQ(x.size(), rest.size());
+
+  // the joined trees keep working
+  for (int key = 0; key < 3 * size; key += 3) {
+    if (x.contains(key)) {
+      x.erase(x.find(key));
+      rest.erase(key);
+    } else {
+      x.insert(key);
+      rest.insert(key);
+    }
+  }
+  EXPECT_TRUE(std::equal(x.begin(), x.end(), rest.begin(), rest.end()));
+  EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), rest.rbegin(), rest.rend()));
+  EXPECT_EQ(x.size(), rest.size());
+}
+
+TEST(Set, Set_Algebra) {
+  using RankedSet = s21::Set<int, std::less<int>, std::allocator<int>,
+                             s21::OrderStatisticTreeBackend>;
+  for (int size : {0, 1, 5, 300, 50000}) {
+    CheckSetAlgebra<s21::Set<int>>(size);
+    CheckSetAlgebra<RankedSet>(size);
+    CheckSetAlgebra<s21::Set<int, std::less<int>, std::allocator<int>,
+                             s21::ThreadedTreeBackend>>(size);
+    CheckSetAlgebra<s21::Set<int, std::less<int>, std::allocator<int>,
+                             s21::CompactTreeBackend>>(size);
+    CheckSetAlgebra<s21::Set<int, std::less<int>, std::allocator<int>,
+                             s21::ArenaTreeBackend>>(size);
+  }
+  CheckSetAlgebra<s21::Set<int, std::less<int>, std::allocator<int>,
+                           s21::BPlusTreeBackend>>(3000);
+
+  RankedSet x, y;
+  for (int i = 0; i < 1000; ++i) x.insert(i);
+  for (int i = 500; i < 1500; ++i) y.insert(i);
+  x.merge(y);
+  EXPECT_EQ(x.rank(1200), 1200U);
+  EXPECT_EQ(*x.select(1499), 1499);
+  EXPECT_EQ(y.size(), 500U);
+}
+
+namespace {
+// counts the blocks it hands out, copies sharing a counter compare equal
+template <class T>
+struct CountingNodeAllocator {
+  using value_type = T;
+
+  explicit CountingNodeAllocator(int *live_) : live(live_) {}
+  template <class U>
+  CountingNodeAllocator(const CountingNodeAllocator<U> &other)
+      : live(other.live) {}
+
+  T *allocate(std::size_t n) {
+    ++*live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    --*live;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <class U>
+  bool operator==(const CountingNodeAllocator<U> &other) const {
+    return live == other.live;
+  }
+  template <class U>
+  bool operator!=(const CountingNodeAllocator<U> &other) const {
+    return live != other.live;
+  }
+
+  int *live;
+};
+}  // namespace
+
+TEST(Set, Allocator_Owns_Every_Node) {
+  using Alloc = CountingNodeAllocator<int>;
+  int live = 0, other_live = 0;
+  {
+    s21::Set<int, std::less<int>, Alloc> x{Alloc(&live)};
+    x.reserve(100);
+    int slabs = live;
+    for (int i = 0; i < 100; ++i) x.insert(i);
+    EXPECT_EQ(live, slabs);
+    s21::Set<int, std::less<int>, Alloc> copy(x);
+    EXPECT_EQ(copy.get_allocator(), x.get_allocator());
+    s21::Set<int, std::less<int>, Alloc> other{Alloc(&other_live)};
+    other = std::move(x);
+    EXPECT_GT(other_live, 0);
+    EXPECT_EQ(other.size(), 100U);
+    EXPECT_TRUE(other.contains(99));
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+  {
+    s21::Set<int, std::less<int>, Alloc, s21::BPlusTreeBackend> x(
+        {3, 1, 2}, std::less<int>(), Alloc(&live));
+    EXPECT_GT(live, 0);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(Stack, Allocator_Owns_Every_Node) {
+  using Alloc = CountingNodeAllocator<std::string>;
+  int live = 0, other_live = 0;
+  {
+    s21::Stack<std::string, Alloc> x({"a", "b", "c"}, Alloc(&live));
+    EXPECT_EQ(live, 3);
+    s21::Stack<std::string, Alloc> copy{Alloc(&live)};
+    copy.push("z");
+    copy = x;
+    EXPECT_EQ(live, 6);
+    EXPECT_EQ(copy.top(), "c");
+    s21::Stack<std::string, Alloc> other{Alloc(&other_live)};
+    other = std::move(x);
+    EXPECT_EQ(live, 3);
+    EXPECT_EQ(other_live, 3);
+    EXPECT_EQ(other.top(), "c");
+    other.pop();
+    EXPECT_EQ(other.top(), "b");
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+}
+
+TEST(Queue, Allocator_Owns_Every_Node) {
+  using Alloc = CountingNodeAllocator<std::string>;
+  int live = 0, other_live = 0;
+  {
+    s21::Queue<std::string, Alloc> x({"a", "b", "c"}, Alloc(&live));
+    EXPECT_EQ(live, 3);
+    s21::Queue<std::string, Alloc> copy{Alloc(&live)};
+    copy.push("z");
+    copy = x;
+    EXPECT_EQ(live, 6);
+    EXPECT_EQ(copy.front(), "a");
+    EXPECT_EQ(copy.size(), 3U);
+    s21::Queue<std::string, Alloc> other{Alloc(&other_live)};
+    other = std::move(x);
+    EXPECT_EQ(live, 3);
+    EXPECT_EQ(other_live, 3);
+    EXPECT_EQ(other.front(), "a");
+    EXPECT_EQ(other.back(), "c");
+  }
+  EXPECT_EQ(live, 0);
+  EXPECT_EQ(other_live, 0);
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../containers/s21_small_vector.h"
+
+TEST(SmallVector_test, stays_inline_up_to_n) {
+  s21::SmallVector<int, 4> vec;
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 4U);
+  vec.insert_many_back(1, 2, 3, 4);
+  EXPECT_TRUE(vec.is_inline());
+  vec.push_back(5);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 8U);
+  vec.erase(vec.cbegin() + 1, vec.cend() - 1);
+  vec.shrink_to_fit();
+  EXPECT_TRUE(vec.is_inline());
+  ASSERT_EQ(vec.size(), 2U);
+  EXPECT_EQ(vec[0], 1);
+  EXPECT_EQ(vec[1], 5);
+}
+
+TEST(SmallVector_test, same_results_as_std_vector) {
+  s21::SmallVector<std::string, 3> s21 = {"a", "b"};
+  std::vector<std::string> stl = {"a", "b"};
+  s21.insert(s21.cbegin() + 1, 3, s21[1]);
+  stl.insert(stl.cbegin() + 1, 3, stl[1]);
+  s21.emplace(s21.cbegin(), 4, 'x');
+  stl.emplace(stl.cbegin(), 4, 'x');
+  s21.insert_many(s21.cbegin() + 2, "m", s21.back());
+  stl.insert(stl.cbegin() + 2, {"m", stl.back()});
+  s21.erase(s21.cbegin());
+  stl.erase(stl.cbegin());
+  s21.resize(12, "z");
+  stl.resize(12, "z");
+  s21::erase_if(s21, [](const std::string &value) { return value == "b"; });
+  stl.erase(std::remove(stl.begin(), stl.end(), "b"), stl.end());
+  ASSERT_EQ(s21.size(), stl.size());
+  for (auto i = 0U; i < s21.size(); ++i) {
+    EXPECT_EQ(s21.at(i), stl[i]);
+  }
+  EXPECT_THROW(s21.at(s21.size()), std::out_of_range);
+}
+
+TEST(SmallVector_test, copy_move_swap) {
+  s21::SmallVector<std::unique_ptr<int>, 2> small;
+  small.emplace_back(new int(1));
+  s21::SmallVector<std::unique_ptr<int>, 2> big;
+  for (int i = 0; i < 5; ++i) big.emplace_back(new int(10 + i));
+  const int *big_data = big[0].get();
+  swap(small, big);
+  EXPECT_EQ(small.size(), 5U);
+  EXPECT_EQ(small[0].get(), big_data);
+  ASSERT_EQ(big.size(), 1U);
+  EXPECT_TRUE(big.is_inline());
+  EXPECT_EQ(*big[0], 1);
+  s21::SmallVector<std::unique_ptr<int>, 2> moved(std::move(small));
+  EXPECT_TRUE(small.empty());
+  EXPECT_TRUE(small.is_inline());
+  EXPECT_EQ(*moved.back(), 14);
+  moved = std::move(big);
+  ASSERT_EQ(moved.size(), 1U);
+  EXPECT_TRUE(moved.is_inline());
+
+  s21::SmallVector<std::string, 2> first = {"a", "b", "c"};
+  s21::SmallVector<std::string, 2> second;
+  second = first;
+  EXPECT_EQ(first, second);
+  second.pop_back();
+  EXPECT_TRUE(second < first);
+  s21::SmallVector<std::string, 2> third(second);
+  EXPECT_EQ(third, second);
+  EXPECT_NE(third, first);
+}
+
+TEST(SmallVector_test, range_insert_and_erase) {
+  s21::SmallVector<int, 4> s21 = {1, 2, 3};
+  std::vector<int> stl = {1, 2, 3};
+  std::vector<int> source = {10, 11, 12, 13};
+  s21.insert(s21.cbegin() + 1, source.begin(), source.begin() + 1);
+  stl.insert(stl.cbegin() + 1, source.begin(), source.begin() + 1);
+  EXPECT_TRUE(s21.is_inline());
+  s21.insert(s21.cbegin() + 2, source.begin(), source.end());
+  stl.insert(stl.cbegin() + 2, source.begin(), source.end());
+  EXPECT_FALSE(s21.is_inline());
+  std::istringstream input("7 8 9");
+  s21.insert(s21.cend(), std::istream_iterator<int>(input),
+             std::istream_iterator<int>());
+  stl.insert(stl.cend(), {7, 8, 9});
+  auto it = s21.erase(s21.cbegin() + 1, s21.cbegin() + 4);
+  stl.erase(stl.cbegin() + 1, stl.cbegin() + 4);
+  EXPECT_EQ(*it, stl[1]);
+  EXPECT_EQ(s21.erase(s21.cbegin(), s21.cbegin()), s21.begin());
+  ASSERT_EQ(s21.size(), stl.size());
+  EXPECT_TRUE(std::equal(s21.cbegin(), s21.cend(), stl.cbegin()));
+}
+
+TEST(SmallVector_test, insert_of_own_elements) {
+  // in place, while growing inline to heap, and while growing on the heap
+  for (std::size_t extra : {0U, 1U, 4U}) {
+    s21::SmallVector<std::string, 4> s21 = {"a", "b", "c"};
+    std::vector<std::string> stl = {"a", "b", "c"};
+    for (std::size_t i = 0; i < extra; ++i) {
+      s21.push_back(std::string(20, 'x'));
+      stl.push_back(std::string(20, 'x'));
+    }
+    s21.insert(s21.cbegin(), s21.back());
+    stl.insert(stl.cbegin(), stl.back());
+    s21.insert(s21.cbegin() + 1, 2, s21[2]);
+    stl.insert(stl.cbegin() + 1, 2, stl[2]);
+    s21.emplace(s21.cbegin(), s21.back());
+    stl.emplace(stl.cbegin(), stl.back());
+    s21.insert_many(s21.cbegin() + 1, s21[0], s21.back());
+    stl.insert(stl.cbegin() + 1, {stl[0], stl.back()});
+    s21.push_back(s21.front());
+    stl.push_back(stl.front());
+    ASSERT_EQ(s21.size(), stl.size());
+    for (auto i = 0U; i < s21.size(); ++i) EXPECT_EQ(s21[i], stl[i]);
+  }
+}
+
+TEST(SmallVector_test, resize) {
+  s21::SmallVector<int, 4> vec = {1, 2};
+  vec.resize(4);
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec[3], 0);
+  vec.resize(9, 7);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(vec.size(), 9U);
+  EXPECT_EQ(vec[4], 7);
+  EXPECT_EQ(vec.back(), 7);
+  vec.resize(1);
+  ASSERT_EQ(vec.size(), 1U);
+  EXPECT_EQ(vec[0], 1);
+  vec.resize(0);
+  EXPECT_TRUE(vec.empty());
+  s21::SmallVector<std::string, 2> strings(3);
+  EXPECT_EQ(strings.size(), 3U);
+  EXPECT_TRUE(strings[2].empty());
+}
+
+TEST(SmallVector_test, shrink_to_fit_moves_elements_back_inline) {
+  s21::SmallVector<std::string, 3> vec;
+  for (int i = 0; i < 10; ++i) vec.push_back(std::string(30, 'a' + i));
+  vec.erase(vec.cbegin() + 2, vec.cend());
+  const char *first_data = vec[0].data();
+  EXPECT_FALSE(vec.is_inline());
+  vec.shrink_to_fit();
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 3U);
+  ASSERT_EQ(vec.size(), 2U);
+  // the strings are moved, not copied
+  EXPECT_EQ(vec[0].data(), first_data);
+  EXPECT_EQ(vec[1], std::string(30, 'b'));
+
+  vec.insert_many_back("c", "d");
+  vec.erase(vec.cbegin());
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 3U);
+  EXPECT_EQ(vec.back(), "d");
+}
+
+TEST(SmallVector_test, comparisons) {
+  s21::SmallVector<int, 2> a = {1, 2, 3};
+  s21::SmallVector<int, 2> b = {1, 2};
+  s21::SmallVector<int, 2> c = {1, 3};
+  EXPECT_TRUE(b < a);
+  EXPECT_TRUE(a < c);
+  EXPECT_TRUE(c > a);
+  EXPECT_TRUE(a <= a);
+  EXPECT_TRUE(a >= b);
+  EXPECT_FALSE(a <= b);
+  EXPECT_FALSE(b >= a);
+  EXPECT_TRUE(a != b);
+  EXPECT_FALSE(a == b);
+  b.push_back(3);
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a < b);
+}
+
+TEST(SmallVector_test, erase_if) {
+  s21::SmallVector<int, 4> vec = {1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(s21::erase_if(vec, [](int value) { return value % 2 == 0; }),
+            3U);
+  std::vector<int> check = {1, 3, 5, 7};
+  ASSERT_EQ(vec.size(), check.size());
+  EXPECT_TRUE(std::equal(vec.cbegin(), vec.cend(), check.cbegin()));
+  EXPECT_EQ(s21::erase_if(vec, [](int value) { return value > 10; }), 0U);
+  EXPECT_EQ(s21::erase_if(vec, [](int) { return true; }), 4U);
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(SmallVector_test, no_inline_capacity) {
+  s21::SmallVector<std::string, 0> vec;
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 0U);
+  vec.push_back("a");
+  EXPECT_FALSE(vec.is_inline());
+  vec.insert_many(vec.cbegin(), "b", vec[0]);
+  ASSERT_EQ(vec.size(), 3U);
+  EXPECT_EQ(vec[0], "b");
+  EXPECT_EQ(vec[1], "a");
+  s21::SmallVector<std::string, 0> copy(vec);
+  s21::SmallVector<std::string, 0> moved(std::move(vec));
+  EXPECT_EQ(copy, moved);
+  EXPECT_TRUE(vec.empty());
+  moved.clear();
+  moved.shrink_to_fit();
+  EXPECT_TRUE(moved.is_inline());
+  EXPECT_EQ(moved.capacity(), 0U);
+  swap(moved, copy);
+  EXPECT_EQ(moved.size(), 3U);
+  EXPECT_TRUE(copy.empty());
+}
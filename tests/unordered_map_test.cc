@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../containers/s21_unordered_map.h"
+#include "../containers/s21_unordered_set.h"
+
+namespace {
+// every key in one probe chain, so lookups cross groups and tombstones
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+// its copies throw once copies_left runs out, its moves may throw
+struct CopyBomb {
+  explicit CopyBomb(int item) : value(item) {}
+  CopyBomb(const CopyBomb& other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("CopyBomb");
+  }
+  CopyBomb(CopyBomb&& other) : value(other.value) {}
+
+  int value;
+  static inline int copies_left = 1 << 30;
+};
+
+// propagates on move assignment but not on swap, all instances are equal
+template <class T>
+struct MoveAssignedAllocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::false_type;
+
+  explicit MoveAssignedAllocator(int value) : tag(value) {}
+  template <class U>
+  MoveAssignedAllocator(const MoveAssignedAllocator<U>& other)
+      : tag(other.tag) {}
+
+  T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+  template <class U>
+  bool operator==(const MoveAssignedAllocator<U>&) const {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const MoveAssignedAllocator<U>&) const {
+    return false;
+  }
+
+  int tag;
+};
+
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view key) const noexcept {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+template <class Hash>
+void CheckAgainstStd(int operations, int key_range) {
+  s21::unordered_map<int, std::string, Hash> table;
+  std::unordered_map<int, std::string> expected;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> key(0, key_range);
+  for (int i = 0; i < operations; ++i) {
+    int k = key(gen);
+    switch (gen() % 4) {
+      case 0:
+        EXPECT_EQ(table.erase(k), expected.erase(k));
+        break;
+      case 1:
+        table.insert_or_assign(k, std::to_string(i));
+        expected.insert_or_assign(k, std::to_string(i));
+        break;
+      default:
+        EXPECT_EQ(table.try_emplace(k, std::to_string(k)).second,
+                  expected.try_emplace(k, std::to_string(k)).second);
+    }
+  }
+  ASSERT_EQ(table.size(), expected.size());
+  std::size_t visited = 0;
+  for (const auto& item : table) {
+    ASSERT_EQ(expected.at(item.first), item.second);
+    ++visited;
+  }
+  EXPECT_EQ(visited, expected.size());
+  for (int k = 0; k <= key_range; ++k) {
+    EXPECT_EQ(table.contains(k), expected.count(k) == 1U);
+  }
+  EXPECT_LE(table.load_factor(), table.max_load_factor());
+}
+
+TEST(UNORDERED_MAP, RANDOM_OPERATIONS_AGREE_WITH_STD) {
+  CheckAgainstStd<std::hash<int>>(20000, 3000);
+  CheckAgainstStd<CollidingHash>(2000, 100);
+}
+
+TEST(UNORDERED_MAP, ACCESS_COPY_AND_ERASE_WHILE_ITERATING) {
+  s21::unordered_map<std::string, int> table{{"one", 1}, {"two", 2}};
+  EXPECT_EQ(table.at("one"), 1);
+  EXPECT_THROW(table.at("three"), std::out_of_range);
+  table["three"] = 3;
+  EXPECT_EQ(table.size(), 3U);
+  EXPECT_FALSE(table.insert({"one", 10}).second);
+  EXPECT_TRUE(table.emplace("four", 4).second);
+  s21::unordered_map<std::string, int> copy = table;
+  for (auto it = copy.begin(); it != copy.end();) {
+    it = it->second % 2 == 0 ? copy.erase(it) : std::next(it);
+  }
+  EXPECT_EQ(copy.size(), 2U);
+  EXPECT_TRUE(copy.contains("three"));
+  EXPECT_EQ(table.size(), 4U);
+  s21::unordered_map<std::string, int> other{{"four", 40}, {"five", 5}};
+  table.merge(other);
+  EXPECT_EQ(table.size(), 5U);
+  EXPECT_EQ(table.at("four"), 4);
+  EXPECT_EQ(other.size(), 1U);
+  table.swap(other);
+  EXPECT_EQ(table.count("four"), 1U);
+  EXPECT_EQ(other.count("five"), 1U);
+}
+
+TEST(UNORDERED_MAP, RESERVE_AND_TRANSPARENT_LOOKUP) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> table;
+  table.reserve(1000);
+  std::size_t buckets = table.bucket_count();
+  EXPECT_GE(buckets * 7 / 8, 1000U);
+  for (int i = 0; i < 1000; ++i) table[std::to_string(i)] = i;
+  EXPECT_EQ(table.bucket_count(), buckets);
+  EXPECT_EQ(table.find(std::string_view("512"))->second, 512);
+  EXPECT_TRUE(table.contains(std::string_view("999")));
+  EXPECT_FALSE(table.contains(std::string_view("1000")));
+  table.clear();
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.begin(), table.end());
+  table.rehash(0);
+  EXPECT_EQ(table.bucket_count(), 0U);
+}
+
+TEST(UNORDERED_MAP, ERASE_AND_REINSERT_KEEPS_CAPACITY) {
+  s21::unordered_map<int, int> table;
+  table.reserve(100);
+  std::size_t buckets = table.bucket_count();
+  for (int round = 0; round < 200; ++round) {
+    for (int i = 0; i < 100; ++i) table[round * 100 + i] = i;
+    for (int i = 0; i < 100; ++i) table.erase(round * 100 + i);
+  }
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(table.bucket_count(), buckets);
+}
+
+TEST(UNORDERED_MAP, FAILED_REHASH_KEEPS_TOMBSTONES_COUNTED) {
+  s21::unordered_map<int, CopyBomb, CollidingHash> table;
+  table.reserve(20);
+  int buckets = static_cast<int>(table.bucket_count());
+  int full = buckets - buckets / 8;
+  for (int i = 0; i < full; ++i) table.try_emplace(i, i);
+  // the first group is full, so its erased slots become tombstones
+  for (int i = 0; i < 10; ++i) table.erase(i);
+
+  CopyBomb::copies_left = 5;
+  EXPECT_THROW(table.rehash(buckets * 2), std::runtime_error);
+  CopyBomb::copies_left = 1 << 30;
+  EXPECT_EQ(table.bucket_count(), static_cast<std::size_t>(buckets));
+  EXPECT_EQ(table.size(), static_cast<std::size_t>(full - 10));
+
+  // inserts after the failure still find room and grow the table
+  for (int i = full; i < full + 100; ++i) table.try_emplace(i, i);
+  for (int i = 10; i < full + 100; ++i) EXPECT_EQ(table.at(i).value, i);
+  EXPECT_EQ(table.size(), static_cast<std::size_t>(full + 90));
+}
+
+TEST(UNORDERED_MAP, RESERVE_PURGES_TOMBSTONES) {
+  s21::unordered_map<int, int> table;
+  table.reserve(800);
+  int buckets = static_cast<int>(table.bucket_count());
+  int full = buckets - buckets / 8;
+  for (int i = 0; i < full; ++i) table[i] = i;
+  for (int i = 0; i < full; i += 2) table.erase(i);
+  table.reserve(full);
+  for (int i = full; table.size() < static_cast<std::size_t>(full); ++i) {
+    table[i] = i;
+  }
+  EXPECT_EQ(table.bucket_count(), static_cast<std::size_t>(buckets));
+}
+
+TEST(UNORDERED_MAP, ALLOCATOR_PROPAGATION) {
+  using Alloc = MoveAssignedAllocator<std::pair<const int, int>>;
+  using Map = s21::unordered_map<int, int, std::hash<int>,
+                                 std::equal_to<int>, Alloc>;
+  Map first(0, std::hash<int>(), std::equal_to<int>(), Alloc(1));
+  Map second(0, std::hash<int>(), std::equal_to<int>(), Alloc(2));
+  first[1] = 1;
+  second[2] = 2;
+  first.swap(second);
+  EXPECT_TRUE(first.contains(2));
+  EXPECT_EQ(first.get_allocator().tag, 1);
+  EXPECT_EQ(second.get_allocator().tag, 2);
+  first = std::move(second);
+  EXPECT_TRUE(first.contains(1));
+  EXPECT_EQ(first.get_allocator().tag, 2);
+}
+
+TEST(UNORDERED_SET, INSERT_FIND_ERASE_AND_MERGE) {
+  std::vector<int> items{5, 1, 9, 1, 5, 7};
+  s21::unordered_set<int> set(items.begin(), items.end());
+  std::unordered_set<int> expected(items.begin(), items.end());
+  EXPECT_EQ(set.size(), expected.size());
+  for (int key : set) EXPECT_EQ(expected.count(key), 1U);
+  EXPECT_FALSE(set.insert(9).second);
+  EXPECT_TRUE(set.emplace(11).second);
+  EXPECT_EQ(*set.find(11), 11);
+  EXPECT_EQ(set.find(12), set.end());
+  EXPECT_EQ(set.erase(1), 1U);
+  EXPECT_EQ(set.erase(1), 0U);
+  s21::unordered_set<int> other{7, 13};
+  set.merge(other);
+  EXPECT_TRUE(set.contains(13));
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_TRUE(other.contains(7));
+}
+}  // namespace
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -192,6 +195,14 @@ TEST(Vector_test, reserve_test) {
   ASSERT_THROW(s21.reserve(s21.max_size() + 1), std::length_error);
 }
 
+TEST(Vector_test, oversized_constructor_throws) {
+  using size_type = s21::Vector<int>::size_type;
+  size_type too_many = s21::Vector<int>().max_size() + 1U;
+  EXPECT_THROW(s21::Vector<int> vec(too_many), std::length_error);
+  EXPECT_THROW(s21::Vector<int> vec(too_many, 7), std::length_error);
+  EXPECT_THROW(s21::Vector<std::string> vec(too_many), std::length_error);
+}
+
 TEST(Vector_test, capacity_test) {
   s21::Vector<int> s21(100);
   std::vector<int> stl(100);
@@ -840,3 +851,270 @@ TEST(Vector_test, insert_many_back3) {
     EXPECT_EQ(vec[i], check);
   }
 }
+
+namespace {
+struct Tracked {
+  static int alive;
+  explicit Tracked(int v) : value(v) { ++alive; }
+  Tracked(const Tracked &other) : value(other.value) { ++alive; }
+  Tracked(Tracked &&other) noexcept : value(other.value) { ++alive; }
+  Tracked &operator=(const Tracked &other) = default;
+  Tracked &operator=(Tracked &&other) = default;
+  ~Tracked() { --alive; }
+  int value;
+};
+int Tracked::alive = 0;
+}  // namespace
+
+TEST(Vector_test, raw_storage_constructs_only_live_elements) {
+  {
+    s21::Vector<Tracked> vec;
+    vec.reserve(100);
+    EXPECT_EQ(Tracked::alive, 0);
+    for (int i = 0; i < 10; ++i) vec.push_back(Tracked(i));
+    EXPECT_EQ(Tracked::alive, 10);
+    vec.insert(vec.begin() + 3, vec[7]);
+    vec.erase(vec.begin());
+    vec.pop_back();
+    EXPECT_EQ(Tracked::alive, 9);
+    vec.resize(4, vec[0]);
+    EXPECT_EQ(Tracked::alive, 4);
+    vec.resize(300, vec[0]);
+    EXPECT_EQ(Tracked::alive, 300);
+    EXPECT_EQ(vec[299].value, 1);
+    EXPECT_EQ(vec[2].value, 7);
+    s21::Vector<Tracked> copy(vec);
+    copy.shrink_to_fit();
+    EXPECT_EQ(Tracked::alive, 600);
+    copy = s21::Vector<Tracked>(5, Tracked(-1));
+    EXPECT_EQ(Tracked::alive, 305);
+    vec.clear();
+    EXPECT_EQ(Tracked::alive, 5);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(Vector_test, push_back_own_element_on_growth) {
+  s21::Vector<std::string> vec = {"first", "second"};
+  vec.push_back(vec[0]);
+  vec.insert(vec.begin(), vec[2]);
+  EXPECT_EQ(vec.size(), 4U);
+  EXPECT_EQ(vec[0], "first");
+  EXPECT_EQ(vec[3], "first");
+  EXPECT_EQ(vec[2], "second");
+}
+
+TEST(Vector_test, move_only_elements) {
+  s21::Vector<std::unique_ptr<int>> vec;
+  vec.push_back(std::make_unique<int>(1));
+  vec.emplace_back(new int(3));
+  vec.emplace(vec.cbegin() + 1, new int(2));
+  vec.insert(vec.begin(), std::make_unique<int>(0));
+  auto it = vec.insert_many(vec.cend(), std::make_unique<int>(4),
+                            std::make_unique<int>(5));
+  EXPECT_EQ(**it, 5);
+  vec.insert_many(vec.cbegin() + 2, std::make_unique<int>(10),
+                  std::make_unique<int>(11));
+  std::vector<int> check = {0, 1, 10, 11, 2, 3, 4, 5};
+  ASSERT_EQ(vec.size(), check.size());
+  for (auto i = 0U; i < vec.size(); ++i) {
+    EXPECT_EQ(*vec[i], check[i]);
+  }
+}
+
+TEST(Vector_test, insert_many_single_shift_without_copies) {
+  s21::Vector<std::string> vec = {"a", "b", "c", "d"};
+  vec.reserve(16);
+  std::string moved(100, 'x');
+  const char *moved_data = moved.data();
+  auto it = vec.insert_many(vec.cbegin() + 1, vec[3], std::move(moved), "z");
+  EXPECT_EQ(*it, "z");
+  EXPECT_EQ(vec[2].data(), moved_data);
+  vec.insert_many_back(vec[0], std::string(3, 'y'));
+  std::vector<std::string> check = {"a", "d", std::string(100, 'x'),
+                                    "z", "b",  "c",
+                                    "d", "a",  "yyy"};
+  ASSERT_EQ(vec.size(), check.size());
+  for (auto i = 0U; i < vec.size(); ++i) {
+    EXPECT_EQ(vec[i], check[i]);
+  }
+  EXPECT_EQ(vec.emplace_back(5, 'q'), "qqqqq");
+  EXPECT_EQ(*vec.emplace(vec.cbegin(), vec.back()), "qqqqq");
+}
+
+TEST(Vector_test, range_insert_and_erase) {
+  s21::Vector<int> s21 = {1, 2, 3, 4, 5};
+  std::vector<int> stl = {1, 2, 3, 4, 5};
+  std::vector<int> source = {10, 11, 12};
+  auto s21_it = s21.insert(s21.cbegin() + 2, source.begin(), source.end());
+  auto stl_it = stl.insert(stl.cbegin() + 2, source.begin(), source.end());
+  EXPECT_EQ(s21_it - s21.begin(), stl_it - stl.begin());
+  s21.insert(s21.cbegin() + 1, 4, s21[6]);
+  stl.insert(stl.cbegin() + 1, 4, stl[6]);
+  s21.insert(s21.cend(), 3U, 7);
+  stl.insert(stl.cend(), 3U, 7);
+  s21_it = s21.erase(s21.cbegin() + 3, s21.cbegin() + 8);
+  stl_it = stl.erase(stl.cbegin() + 3, stl.cbegin() + 8);
+  EXPECT_EQ(s21_it - s21.begin(), stl_it - stl.begin());
+  s21.erase(s21.cbegin(), s21.cbegin());
+  EXPECT_EQ(s21.capacity(), stl.capacity());
+  ASSERT_EQ(s21.size(), stl.size());
+  for (auto i = 0U; i < s21.size(); ++i) {
+    EXPECT_EQ(s21[i], stl[i]);
+  }
+}
+
+TEST(Vector_test, range_insert_input_iterator_and_erase_if) {
+  s21::Vector<std::string> vec = {"a", "b"};
+  std::istringstream input("x yy zzz");
+  vec.insert(vec.cbegin() + 1, std::istream_iterator<std::string>(input),
+             std::istream_iterator<std::string>());
+  std::vector<std::string> check = {"a", "x", "yy", "zzz", "b"};
+  ASSERT_EQ(vec.size(), check.size());
+  for (auto i = 0U; i < vec.size(); ++i) {
+    EXPECT_EQ(vec[i], check[i]);
+  }
+  auto removed = s21::erase_if(
+      vec, [](const std::string &value) { return value.size() == 1U; });
+  EXPECT_EQ(removed, 3U);
+  ASSERT_EQ(vec.size(), 2U);
+  EXPECT_EQ(vec[0], "yy");
+  EXPECT_EQ(vec[1], "zzz");
+}
+
+namespace {
+struct Boxed {
+  explicit Boxed(int v) : value(std::make_shared<int>(v)) {}
+  std::shared_ptr<int> value;
+};
+}  // namespace
+
+template <>
+struct s21::is_trivially_relocatable<Boxed> : std::true_type {};
+
+TEST(Vector_test, trivially_relocatable_growth) {
+  s21::Vector<Boxed> vec;
+  for (int i = 0; i < 1000; ++i) {
+    vec.emplace_back(i);
+  }
+  vec.insert(vec.cbegin() + 10, Boxed(-1));
+  vec.erase(vec.cbegin());
+  vec.resize(1200, Boxed(7));
+  EXPECT_EQ(*vec[1199].value, 7);
+  EXPECT_EQ(vec[1199].value.use_count(), 200);
+  vec.resize(500, Boxed(7));
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 500U);
+  EXPECT_EQ(*vec[0].value, 1);
+  EXPECT_EQ(*vec[9].value, -1);
+  EXPECT_EQ(*vec[499].value, 499);
+}
+
+TEST(Vector_test, huge_buffer_growth_keeps_contents) {
+  s21::Vector<int> vec(1000, 3);
+  vec.resize(9000000, 7);
+  vec.reserve(20000000);
+  EXPECT_EQ(vec.capacity(), 20000000U);
+  vec.push_back(vec[0]);
+  EXPECT_EQ(vec[999], 3);
+  EXPECT_EQ(vec[1000], 7);
+  EXPECT_EQ(vec[8999999], 7);
+  EXPECT_EQ(vec.back(), 3);
+  vec.resize(10);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 10U);
+  EXPECT_EQ(vec[9], 3);
+}
+
+namespace {
+// allocator with identity: instances compare equal only to their copies
+template <class T, bool kPropagate>
+struct TaggedAllocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment =
+      std::integral_constant<bool, kPropagate>;
+  using propagate_on_container_swap = std::integral_constant<bool, kPropagate>;
+
+  explicit TaggedAllocator(int id_, int *live_ = nullptr)
+      : id(id_), live(live_) {}
+  template <class U>
+  TaggedAllocator(const TaggedAllocator<U, kPropagate> &other)
+      : id(other.id), live(other.live) {}
+
+  T *allocate(std::size_t n) {
+    if (live) ++*live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    if (live) --*live;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <class U>
+  bool operator==(const TaggedAllocator<U, kPropagate> &other) const {
+    return id == other.id;
+  }
+  template <class U>
+  bool operator!=(const TaggedAllocator<U, kPropagate> &other) const {
+    return id != other.id;
+  }
+
+  int id;
+  int *live;
+};
+}  // namespace
+
+TEST(Vector_test, allocator_is_used_and_kept) {
+  int live = 0;
+  using Alloc = TaggedAllocator<std::string, false>;
+  {
+    s21::Vector<std::string, Alloc> first(Alloc(1, &live));
+    first.insert_many_back("a", "b", "c");
+    EXPECT_EQ(live, 1);
+    s21::Vector<std::string, Alloc> copy(first);
+    EXPECT_EQ(copy.get_allocator().id, 1);
+    EXPECT_EQ(live, 2);
+
+    // equal allocators: the buffer changes hands
+    const std::string *data = first.data();
+    s21::Vector<std::string, Alloc> same(Alloc(1, &live));
+    same = std::move(first);
+    EXPECT_EQ(same.data(), data);
+    EXPECT_EQ(live, 2);
+
+    // unequal, non-propagating allocators: the elements are moved over
+    s21::Vector<std::string, Alloc> other(Alloc(2, &live));
+    other = std::move(same);
+    EXPECT_EQ(other.get_allocator().id, 2);
+    EXPECT_NE(other.data(), data);
+    ASSERT_EQ(other.size(), 3U);
+    EXPECT_EQ(other[2], "c");
+    EXPECT_TRUE(same.empty());
+
+    s21::Vector<std::string, Alloc> moved(std::move(other), Alloc(3, &live));
+    EXPECT_EQ(moved.get_allocator().id, 3);
+    EXPECT_EQ(moved[0], "a");
+    s21::erase_if(moved, [](const std::string &value) { return value < "b"; });
+    EXPECT_EQ(moved.size(), 2U);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(Vector_test, allocator_propagates_on_move_and_swap) {
+  using Alloc = TaggedAllocator<int, true>;
+  s21::Vector<int, Alloc> first({1, 2, 3}, Alloc(1));
+  s21::Vector<int, Alloc> second(Alloc(2));
+  const int *data = first.data();
+  second = std::move(first);
+  EXPECT_EQ(second.get_allocator().id, 1);
+  EXPECT_EQ(second.data(), data);
+  s21::Vector<int, Alloc> third(2U, 9, Alloc(3));
+  swap(second, third);
+  EXPECT_EQ(second.get_allocator().id, 3);
+  EXPECT_EQ(third.get_allocator().id, 1);
+  EXPECT_EQ(third.data(), data);
+  EXPECT_EQ(second[1], 9);
+}
+
+TEST(Vector_test, default_allocator_takes_no_space) {
+  EXPECT_EQ(sizeof(s21::Vector<int>), 3U * sizeof(void *));
+}